@@ -0,0 +1,97 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+#include "../common/array.hpp"
+#include "../common/defs.hpp"
+#include "../common/halo_descriptor.hpp"
+
+/**
+@file
+@brief Communication avoiding deep halos.
+
+The fields are allocated with halos which are `cadence` times as wide as a single time step needs. The halos are
+exchanged only every `cadence` steps; in between the stencils are computed on a domain that is extended into the
+halo by the amount the remaining steps of the cycle will read, so the extended domain shrinks by the stencil extent
+at every step. This trades redundant computation for a `cadence` times smaller number of messages.
+*/
+
+namespace gridtools {
+    namespace boundaries {
+        /** \ingroup Distributed-Boundaries
+         * @{
+         */
+
+        /**
+           @brief Keeps track of the position within the exchange cycle and computes the extended compute domain
+           of every step.
+         */
+        class deep_halo_schedule {
+            array<halo_descriptor, 3> m_halos;
+            uint_t m_cadence;
+            uint_t m_position;
+
+          public:
+            /**
+               \param halos halos of the fields, wide enough for `cadence` steps
+               \param cadence number of time steps per halo exchange
+            */
+            deep_halo_schedule(array<halo_descriptor, 3> const &halos, uint_t cadence = 1)
+                : m_halos(halos), m_cadence(cadence), m_position(cadence - 1) {
+                if (cadence == 0)
+                    throw std::invalid_argument("The cadence of the halo exchange must be positive");
+            }
+
+            uint_t cadence() const { return m_cadence; }
+
+            /** Position of the current step within the exchange cycle, 0 is the step with the exchange. */
+            uint_t position() const { return m_position; }
+
+            /** Advances to the next step, returns true if the halos have to be exchanged before it. */
+            bool next_step() {
+                m_position = (m_position + 1) % m_cadence;
+                return m_position == 0;
+            }
+
+            /**
+               @brief Halo descriptors describing the compute domain of the current step.
+
+               The domain is extended into the halos by the extent that the stencil reads in the remaining steps of
+               the cycle. Throws if the halos are not wide enough for a full cycle with the given extent.
+
+               \tparam Extent extent of the fields read by the stencil (e.g. from `stencil::get_arg_extent`)
+            */
+            template <class Extent>
+            array<halo_descriptor, 3> compute_halos(Extent) const {
+                int_t remaining = m_cadence - 1 - m_position;
+                int_t minus[2] = {-Extent::iminus::value, -Extent::jminus::value};
+                int_t plus[2] = {Extent::iplus::value, Extent::jplus::value};
+                array<halo_descriptor, 3> res = m_halos;
+                for (int d = 0; d != 2; ++d) {
+                    halo_descriptor const &h = m_halos[d];
+                    if (int_t(h.minus()) < int_t(m_cadence) * minus[d] || int_t(h.plus()) < int_t(m_cadence) * plus[d])
+                        throw std::runtime_error("Halo in dimension " + std::to_string(d) +
+                                                 " is too thin for exchanging every " + std::to_string(m_cadence) +
+                                                 " steps");
+                    res[d] = halo_descriptor(h.minus() - remaining * minus[d],
+                        h.plus() - remaining * plus[d],
+                        h.begin() - remaining * minus[d],
+                        h.end() + remaining * plus[d],
+                        h.total_length());
+                }
+                return res;
+            }
+        };
+        /** @} */
+    } // namespace boundaries
+} // namespace gridtools
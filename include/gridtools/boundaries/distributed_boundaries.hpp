@@ -13,7 +13,9 @@
 /** \defgroup Distributed-Boundaries Distributed Boundary Conditions
  */
 
+#include <cstddef>
 #include <memory>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -21,6 +23,8 @@
 #include "../common/timer/timer.hpp"
 #include "../gcl/halo_exchange.hpp"
 #include "bound_bc.hpp"
+#include "deep_halo.hpp"
+#include "fused_apply.hpp"
 #include "grid_predicate.hpp"
 #include "predicate.hpp"
 
@@ -62,6 +66,12 @@ namespace gridtools {
                               d);
             \endverbatim
 
+            With a cadence `k` greater than one the halos passed to the constructor are assumed to be deep enough for
+            `k` time steps (see gridtools::boundaries::deep_halo_schedule): the communication is performed only by
+            every `k`-th call to gridtools::distributed_boundaries::exchange, while the boundary conditions are applied
+            by every call. In between the stencils have to be run on the domain given by
+            gridtools::distributed_boundaries::compute_halos.
+
             \tparam CTraits Communication traits. To see an example see gridtools::comm_traits
         */
         template <typename CTraits>
@@ -79,6 +89,8 @@ namespace gridtools {
             array<int_t, 3> m_sizes;
             uint_t m_max_stores;
             std::unique_ptr<pattern_type> m_he;
+            deep_halo_schedule m_schedule;
+            bool m_fuse_boundaries = false;
 
             performance_meter_t m_meter_pack;
             performance_meter_t m_meter_exchange;
@@ -95,13 +107,16 @@ namespace gridtools {
                in communication. PAssing more will couse a runtime error (probably segmentation fault), passing less
                will underutilize the memory \param CartComm MPI communicator to use in the halo update operation [must
                be a cartesian communicator]
+                \param cadence Number of calls to exchange per actual halo update, the halos must be deep enough
             */
             distributed_boundaries(array<halo_descriptor, 3> halos,
                 typename pattern_type::grid_type::period_type period,
                 uint_t max_stores,
-                MPI_Comm CartComm)
+                MPI_Comm CartComm,
+                uint_t cadence = 1)
                 : m_halos{halos}, m_sizes{0, 0, 0}, m_max_stores{max_stores},
-                  m_he(std::make_unique<pattern_type>(period, CartComm)), m_meter_pack("pack/unpack       "),
+                  m_he(std::make_unique<pattern_type>(period, CartComm)), m_schedule(halos, cadence),
+                  m_meter_pack("pack/unpack       "),
                   m_meter_exchange("exchange          "), m_meter_bc("boundary condition") {
                 m_he->pattern().proc_grid().fill_dims(m_sizes);
 
@@ -140,8 +155,22 @@ namespace gridtools {
             */
             template <typename... Jobs>
             void boundary_only(Jobs const &...jobs) {
-                using execute_in_order = int[];
                 m_meter_bc.start();
+                if constexpr (std::is_same_v<typename CTraits::comm_arch_type, gcl::cpu>) {
+                    if (m_fuse_boundaries) {
+                        // all the boundary conditions of all the jobs are applied in a single parallel loop
+                        std::apply(
+                            [&](auto const &...boundary_jobs) {
+                                fused_boundary_apply<proc_grid_predicate<typename pattern_type::grid_type>>(
+                                    m_halos, make_proc_grid_predicate(m_he->comm()))
+                                    .apply(boundary_jobs...);
+                            },
+                            std::tuple_cat(make_boundary_jobs(jobs)...));
+                        m_meter_bc.pause();
+                        return;
+                    }
+                }
+                using execute_in_order = int[];
                 (void)execute_in_order{(apply_boundary(jobs), 0)...};
                 m_meter_bc.pause();
             }
@@ -153,7 +182,8 @@ namespace gridtools {
                 (that will be indicated with the gridtools::bound_bc::associate member function.)
 
                 The function first perform communication then applies the boundary condition. This allows a
-               copy-boundary from the inner region to the halo region to run as expected.
+               copy-boundary from the inner region to the halo region to run as expected. With a cadence greater
+               than one the communication is skipped unless the halos are due for an update.
 
                 \param jobs Variadic list of jobs
             */
@@ -166,40 +196,69 @@ namespace gridtools {
                     throw std::runtime_error(err);
                 }
 
-                m_meter_pack.start();
-                call_pack(all_stores_for_exc, std::make_integer_sequence<uint_t, sizeof...(jobs)>{});
-                m_meter_pack.pause();
-                m_meter_exchange.start();
-                m_he->exchange();
-                m_meter_exchange.pause();
-                m_meter_pack.start();
-                call_unpack(all_stores_for_exc, std::make_integer_sequence<uint_t, sizeof...(jobs)>{});
-                m_meter_pack.pause();
+                if (m_schedule.next_step())
+                    halo_update(all_stores_for_exc, std::make_integer_sequence<uint_t, sizeof...(jobs)>{});
 
                 boundary_only(jobs...);
             }
 
+            /**
+                @brief Halo descriptors of the domain on which the stencils of the current time step have to be
+                computed, see gridtools::boundaries::deep_halo_schedule::compute_halos.
+
+                \param extent Extent of the fields read by the stencil
+            */
+            template <typename Extent>
+            array<halo_descriptor, 3> compute_halos(Extent extent) const {
+                return m_schedule.compute_halos(extent);
+            }
+
+            deep_halo_schedule const &schedule() const { return m_schedule; }
+
+            /**
+                @brief Enables the application of all the boundary conditions of a call in a single parallel loop
+                (see gridtools::boundaries::fused_boundary_apply). Only effective for gcl::cpu, disabled by default.
+
+                The halo regions and the jobs are then processed concurrently. This is only correct if the boundary
+                conditions read no halo points (like a corner computed from an edge) and if no field that is written
+                by a job is read or written by any other job of the same call.
+            */
+            void fuse_boundaries(bool value) { m_fuse_boundaries = value; }
+
             auto const &proc_grid() const { return m_he->comm(); }
 
             std::string print_meters() const {
                 return m_meter_pack.to_string() + "\n" + m_meter_exchange.to_string() + "\n" + m_meter_bc.to_string();
             }
 
-            double get_time_pack() const { return m_meter_pack.get_time(); }
-            double get_time_exchange() const { return m_meter_exchange.get_time(); }
-            double get_time_boundary() const { return m_meter_bc.get_time(); }
+            double get_time_pack() const { return m_meter_pack.total_time(); }
+            double get_time_exchange() const { return m_meter_exchange.total_time(); }
+            double get_time_boundary() const { return m_meter_bc.total_time(); }
 
-            size_t get_count_exchange() const { return m_meter_exchange.get_count(); }
+            size_t get_count_exchange() const { return m_meter_exchange.count(); }
             // no get_count_pack() as it is equivalent to get_count_exchange()
-            size_t get_count_boundary() const { return m_meter_bc.get_count(); }
+            size_t get_count_boundary() const { return m_meter_bc.count(); }
 
             void reset_meters() {
-                m_meter_pack.reset_meter();
-                m_meter_exchange.reset_meter();
-                m_meter_bc.reset_meter();
+                m_meter_pack.reset();
+                m_meter_exchange.reset();
+                m_meter_bc.reset();
             }
 
           private:
+            template <typename Stores, typename Ids>
+            void halo_update(Stores const &stores, Ids ids) {
+                m_meter_pack.start();
+                call_pack(stores, ids);
+                m_meter_pack.pause();
+                m_meter_exchange.start();
+                m_he->exchange();
+                m_meter_exchange.pause();
+                m_meter_pack.start();
+                call_unpack(stores, ids);
+                m_meter_pack.pause();
+            }
+
             template <typename BoundaryApply, typename ArgsTuple, uint_t... Ids>
             static void call_apply(
                 BoundaryApply boundary_apply, ArgsTuple const &args, std::integer_sequence<uint_t, Ids...>) {
@@ -219,6 +278,22 @@ namespace gridtools {
                 /* do nothing for a pure data_store*/
             }
 
+            template <typename BoundaryFunction, typename Stores, std::size_t... Ids>
+            static auto make_boundary_job_impl(
+                BoundaryFunction const &boundary_function, Stores const &stores, std::index_sequence<Ids...>) {
+                return make_boundary_job(boundary_function, std::get<Ids>(stores)->target_view()...);
+            }
+
+            template <typename BCApply>
+            static auto make_boundary_jobs(BCApply const &bcapply) {
+                if constexpr (is_bound_bc<BCApply>::value)
+                    return std::make_tuple(make_boundary_job_impl(bcapply.boundary_to_apply(),
+                        bcapply.stores(),
+                        std::make_index_sequence<std::tuple_size_v<typename BCApply::stores_type>>()));
+                else
+                    return std::tuple<>();
+            }
+
             template <typename FirstJob>
             static auto collect_stores(
                 FirstJob const &firstjob, std::enable_if_t<is_bound_bc<FirstJob>::value, void *> = nullptr) {
@@ -0,0 +1,189 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../common/array.hpp"
+#include "../common/defs.hpp"
+#include "../common/for_each.hpp"
+#include "../common/halo_descriptor.hpp"
+#include "../common/integral_constant.hpp"
+#include "../common/omp.hpp"
+#include "../meta.hpp"
+#include "direction.hpp"
+#include "predicate.hpp"
+
+/**
+@file
+@brief Single pass application of several boundary conditions on all the halo regions.
+
+`boundary_apply` opens one parallel loop per direction, which is mostly overhead for thin halos. Here all the active
+regions (after the predicate) of all the jobs are enumerated up front and split into lines along `i`, which are then
+distributed in one parallel loop.
+*/
+
+namespace gridtools {
+    namespace boundaries {
+        /** \ingroup Boundary-Conditions
+         * @{
+         */
+
+        namespace fused_apply_impl_ {
+            // all 26 directions, in the same order as in `boundary_apply::apply`
+            using minus_zero_plus_t = meta::
+                list<integral_constant<sign, minus_>, integral_constant<sign, zero_>, integral_constant<sign, plus_>>;
+            template <class L>
+            using list_to_direction =
+                direction<meta::at_c<L, 0>::value, meta::at_c<L, 1>::value, meta::at_c<L, 2>::value>;
+            using is_not_center = meta::not_<meta::curry<std::is_same, direction<zero_, zero_, zero_>>::template apply>;
+            using directions_t = meta::filter<is_not_center::template apply,
+                meta::transform<list_to_direction,
+                    meta::cartesian_product<minus_zero_plus_t, minus_zero_plus_t, minus_zero_plus_t>>>;
+
+            constexpr std::size_t num_directions = meta::length<directions_t>::value;
+
+            struct region {
+                std::size_t direction;
+                int_t i_low, i_high, j_low, k_low, k_size;
+            };
+
+            template <class F, std::size_t... Is>
+            void dispatch_direction(std::size_t direction, F &&f, std::index_sequence<Is...>) {
+                (void)(... || (direction == Is && (f(meta::at_c<directions_t, Is>()), true)));
+            }
+
+            // applies `job` on `count` consecutive lines of the region, starting at line `first`
+            template <class Job, class Direction>
+            void apply_lines(Job const &job, Direction, region const &reg, int_t first, int_t count) {
+                int_t j = reg.j_low + first / reg.k_size;
+                int_t k = reg.k_low + first % reg.k_size;
+                int_t k_end = reg.k_low + reg.k_size;
+                for (; count > 0; --count) {
+                    job(Direction(), reg.i_low, reg.i_high, j, k);
+                    if (++k == k_end) {
+                        k = reg.k_low;
+                        ++j;
+                    }
+                }
+            }
+        } // namespace fused_apply_impl_
+
+        /**
+           @brief A boundary function bound to the views of the data fields it is applied to.
+         */
+        template <class BoundaryFunction, class... DataFieldViews>
+        struct boundary_job {
+            BoundaryFunction boundary_function;
+            std::tuple<DataFieldViews...> data_field_views;
+
+            template <class Direction>
+            void operator()(Direction, int_t i_low, int_t i_high, int_t j, int_t k) const {
+                std::apply(
+                    [&](auto const &...views) {
+#pragma omp simd
+                        for (int_t i = i_low; i <= i_high; ++i)
+                            boundary_function(Direction(), views..., i, j, k);
+                    },
+                    data_field_views);
+            }
+        };
+
+        template <class BoundaryFunction, class... DataFieldViews>
+        boundary_job<BoundaryFunction, DataFieldViews...> make_boundary_job(
+            BoundaryFunction const &boundary_function, DataFieldViews const &...data_field_views) {
+            return {boundary_function, {data_field_views...}};
+        }
+
+        /**
+           @brief Applies several boundary jobs on all the halo regions selected by the predicate in a single
+           parallel loop.
+
+           The regions are the same as in `boundary_apply`, but they are processed concurrently and in no particular
+           order. The boundary functions must therefore read only points that are not written by any job (no corner
+           from edge or zero gradient conditions), and the fields written by a job must not be used by other jobs.
+         */
+        template <class Predicate = default_predicate, class HaloDescriptors = array<halo_descriptor, 3u>>
+        struct fused_boundary_apply {
+          private:
+            HaloDescriptors halo_descriptors;
+            Predicate predicate;
+
+          public:
+            fused_boundary_apply(HaloDescriptors const &hd, Predicate predicate = Predicate())
+                : halo_descriptors(hd), predicate(predicate) {}
+
+            template <class... Jobs>
+            void apply(Jobs const &...jobs) const {
+                using namespace fused_apply_impl_;
+                if constexpr (sizeof...(Jobs) != 0) {
+                    array<region, num_directions> regions;
+                    array<int_t, num_directions + 1> offsets;
+                    std::size_t num_regions = 0;
+                    offsets[0] = 0;
+                    for_each<meta::make_indices_c<num_directions>>([&](auto index) {
+                        using direction_t = meta::at<directions_t, decltype(index)>;
+                        if (!predicate(direction_t()))
+                            return;
+                        region r = {decltype(index)::value,
+                            halo_descriptors[0].loop_low_bound_outside(direction_t::i),
+                            halo_descriptors[0].loop_high_bound_outside(direction_t::i),
+                            halo_descriptors[1].loop_low_bound_outside(direction_t::j),
+                            halo_descriptors[2].loop_low_bound_outside(direction_t::k),
+                            halo_descriptors[2].loop_high_bound_outside(direction_t::k) -
+                                halo_descriptors[2].loop_low_bound_outside(direction_t::k) + 1};
+                        int_t j_size = halo_descriptors[1].loop_high_bound_outside(direction_t::j) - r.j_low + 1;
+                        if (r.i_high < r.i_low || j_size <= 0 || r.k_size <= 0)
+                            return;
+                        regions[num_regions] = r;
+                        offsets[num_regions + 1] = offsets[num_regions] + j_size * r.k_size;
+                        ++num_regions;
+                    });
+                    int_t lines_per_job = offsets[num_regions];
+                    int_t num_lines = lines_per_job * int_t(sizeof...(Jobs));
+                    std::tuple<Jobs const &...> jobs_tuple(jobs...);
+
+#pragma omp parallel
+                    {
+                        // every thread gets a contiguous range of lines, which is split into (job, region) segments
+                        int_t num_threads = omp_get_num_threads();
+                        int_t thread = omp_get_thread_num();
+                        int_t begin = num_lines * thread / num_threads;
+                        int_t end = num_lines * (thread + 1) / num_threads;
+                        for_each<meta::make_indices_c<sizeof...(Jobs)>>([&](auto job) {
+                            int_t job_offset = decltype(job)::value * lines_per_job;
+                            for (std::size_t r = 0; r != num_regions; ++r) {
+                                int_t first = std::max(begin, job_offset + offsets[r]);
+                                int_t last = std::min(end, job_offset + offsets[r + 1]);
+                                if (first >= last)
+                                    continue;
+                                dispatch_direction(
+                                    regions[r].direction,
+                                    [&](auto direction) {
+                                        apply_lines(std::get<decltype(job)::value>(jobs_tuple),
+                                            direction,
+                                            regions[r],
+                                            first - job_offset - offsets[r],
+                                            last - first);
+                                    },
+                                    std::make_index_sequence<num_directions>());
+                            }
+                        });
+                    }
+                }
+            }
+        };
+        /** @} */
+    } // namespace boundaries
+} // namespace gridtools
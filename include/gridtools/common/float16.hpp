@@ -0,0 +1,124 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "host_device.hpp"
+
+/**
+ *  @file
+ *  16 bit floating point storage types.
+ *
+ *  `float16_t` is the IEEE 754 binary16 format (5 bits exponent, 10 bits mantissa), `bfloat16_t` is the upper half
+ *  of a binary32 (8 bits exponent, 7 bits mantissa). They are meant to store fields in memory only: they convert
+ *  implicitly from any arithmetic type and to `float`, the arithmetic is done in the type they are converted to.
+ *
+ *  The conversions are branch free integer and float operations (rounding to nearest even), so that loops that
+ *  load or store these types are vectorized by the compiler and the same code runs on the device.
+ */
+
+namespace gridtools {
+    namespace float16_impl_ {
+        GT_FUNCTION std::uint32_t to_bits(float src) {
+            std::uint32_t res;
+            std::memcpy(&res, &src, sizeof(res));
+            return res;
+        }
+
+        GT_FUNCTION float from_bits(std::uint32_t src) {
+            float res;
+            std::memcpy(&res, &src, sizeof(res));
+            return res;
+        }
+
+        // bitwise select instead of a conditional, the compilers do not if-convert floating point operations
+        GT_FUNCTION std::uint32_t select(bool cond, std::uint32_t lhs, std::uint32_t rhs) {
+            std::uint32_t mask = -std::uint32_t(cond);
+            return (lhs & mask) | (rhs & ~mask);
+        }
+
+        struct binary16 {
+            GT_FUNCTION static std::uint16_t encode(float src) {
+                constexpr std::uint32_t f32_inf = 255u << 23;
+                constexpr std::uint32_t f16_max = (127u + 16) << 23;
+                constexpr std::uint32_t denorm_magic = ((127u - 15) + (23 - 10) + 1) << 23;
+                std::uint32_t bits = to_bits(src);
+                std::uint32_t sign = bits & 0x80000000u;
+                bits ^= sign;
+                // overflow to infinity, NaN is kept quiet
+                std::uint32_t huge = bits > f32_inf ? 0x7e00u : 0x7c00u;
+                // subnormal results are rounded by the float addition
+                std::uint32_t tiny = to_bits(from_bits(bits) + from_bits(denorm_magic)) - denorm_magic;
+                // normal results: rebias the exponent and round the mantissa to nearest even
+                std::uint32_t normal = (bits + ((15u - 127) << 23) + 0xfff + ((bits >> 13) & 1)) >> 13;
+                std::uint32_t res = select(bits >= f16_max, huge, select(bits < (113u << 23), tiny, normal));
+                return std::uint16_t(res | (sign >> 16));
+            }
+
+            GT_FUNCTION static float decode(std::uint16_t src) {
+                constexpr std::uint32_t shifted_exp = 0x7c00u << 13;
+                std::uint32_t bits = (src & 0x7fffu) << 13;
+                std::uint32_t exp = bits & shifted_exp;
+                bits += (127u - 15) << 23;
+                // infinity and NaN
+                std::uint32_t special = bits + ((128u - 16) << 23);
+                // zero and subnormals are renormalized by the float subtraction
+                std::uint32_t denormal = to_bits(from_bits(bits + (1u << 23)) - from_bits(113u << 23));
+                bits = select(exp == shifted_exp, special, select(exp == 0, denormal, bits));
+                return from_bits(bits | (std::uint32_t(src & 0x8000u) << 16));
+            }
+        };
+
+        struct bfloat16 {
+            GT_FUNCTION static std::uint16_t encode(float src) {
+                std::uint32_t bits = to_bits(src);
+                std::uint32_t rounded = (bits + 0x7fffu + ((bits >> 16) & 1)) >> 16;
+                // NaN is kept quiet instead of being rounded to infinity
+                return std::uint16_t(select((bits & 0x7fffffffu) > 0x7f800000u, (bits >> 16) | 0x40u, rounded));
+            }
+
+            GT_FUNCTION static float decode(std::uint16_t src) { return from_bits(std::uint32_t(src) << 16); }
+        };
+
+        template <class Format>
+        class reduced_float {
+            std::uint16_t m_bits;
+
+          public:
+            reduced_float() = default;
+
+            template <class T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+            GT_FUNCTION reduced_float(T src) : m_bits(Format::encode(static_cast<float>(src))) {}
+
+            // stores the bits directly, assigning a converted temporary is not vectorized by gcc
+            template <class T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+            GT_FUNCTION reduced_float &operator=(T src) {
+                m_bits = Format::encode(static_cast<float>(src));
+                return *this;
+            }
+
+            GT_FUNCTION operator float() const { return Format::decode(m_bits); }
+
+            GT_FUNCTION std::uint16_t bits() const { return m_bits; }
+
+            GT_FUNCTION static reduced_float from_bits(std::uint16_t bits) {
+                reduced_float res;
+                res.m_bits = bits;
+                return res;
+            }
+        };
+    } // namespace float16_impl_
+
+    using float16_t = float16_impl_::reduced_float<float16_impl_::binary16>;
+    using bfloat16_t = float16_impl_::reduced_float<float16_impl_::bfloat16>;
+} // namespace gridtools
@@ -29,6 +29,8 @@
 #include <unistd.h>
 #endif
 
+#include "memory_accounting.hpp"
+
 namespace gridtools {
     namespace hugepage_alloc_impl_ {
         inline std::size_t ilog2(std::size_t i) {
@@ -183,7 +185,7 @@ namespace gridtools {
         }
 
         struct ptr_metadata {
-            std::size_t offset, full_size;
+            std::size_t offset, full_size, requested_size;
             hugepage_mode mode;
         };
 
@@ -203,11 +205,13 @@ namespace gridtools {
 
         // allocate memory with additional space for offsetting
         void *ptr;
-        std::tie(ptr, size) = hugepage_alloc_impl_::allocate(size + offset, mode);
+        std::size_t full_size;
+        std::tie(ptr, full_size) = hugepage_alloc_impl_::allocate(size + offset, mode);
+        memory_accounting::allocated(memory_accounting::category::hugepage, full_size, full_size - size);
 
         // offset pointer and write pointer metadata required for deallocation
         ptr = static_cast<char *>(ptr) + offset;
-        static_cast<hugepage_alloc_impl_::ptr_metadata *>(ptr)[-1] = {offset, size, mode};
+        static_cast<hugepage_alloc_impl_::ptr_metadata *>(ptr)[-1] = {offset, full_size, size, mode};
         return ptr;
     }
 
@@ -219,6 +223,9 @@ namespace gridtools {
             return;
         // read pointer metadata and compute originally allocated ptr value
         auto &metadata = static_cast<hugepage_alloc_impl_::ptr_metadata *>(ptr)[-1];
+        memory_accounting::deallocated(memory_accounting::category::hugepage,
+            metadata.full_size,
+            metadata.full_size - metadata.requested_size);
         // free originally allocated pointer
         hugepage_alloc_impl_::deallocate(static_cast<char *>(ptr) - metadata.offset, metadata.full_size, metadata.mode);
     }
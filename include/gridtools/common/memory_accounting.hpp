@@ -0,0 +1,292 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+/**
+ *  @file
+ *  Accounting of the memory allocated by GridTools.
+ *
+ *  The allocations are accounted at several layers, a byte may therefore appear in more than one category:
+ *    - `hugepage`: the memory obtained by `hugepage_alloc`, the waste is the rounding to (huge) pages and the cache
+ *      set offset,
+ *    - `storage`: the target memory of the data stores, the waste is the padding and the alignment,
+ *    - `temporaries`: the buffers handed out by `sid::allocator` and `sid::cached_allocator`, which are used for the
+ *      temporaries of the stencil backends and the reductions,
+ *    - `allocator_cache`: the buffers that are kept alive by the caches of `sid::cached_allocator` while no
+ *      allocator uses them.
+ *
+ *  The `storage` and `temporaries` bytes that the calling thread allocates while a `computation_scope` is alive are
+ *  also attributed to the computation with the name of the scope.
+ *
+ *  `to_json` and `dump_json` report all counters. If the environment variable `GT_MEMORY_REPORT` is set to a file
+ *  name, the report is written to that file at program exit.
+ */
+
+namespace gridtools {
+    namespace memory_accounting {
+        enum class category { hugepage, storage, temporaries, allocator_cache };
+
+        constexpr int num_categories = 4;
+
+        inline char const *name(category c) {
+            static char const *const names[num_categories] = {"hugepage", "storage", "temporaries", "allocator_cache"};
+            return names[(int)c];
+        }
+
+        struct stats {
+            // bytes that are currently allocated
+            std::size_t live_bytes = 0;
+            // maximum of `live_bytes` since the start of the program or the last call of `reset_peaks`
+            std::size_t peak_bytes = 0;
+            // part of `live_bytes` that is not requested by the user: rounding, padding and alignment
+            std::size_t waste_bytes = 0;
+            // number and total bytes of all allocations
+            std::size_t allocations = 0;
+            std::size_t allocated_bytes = 0;
+        };
+
+        struct computation_stats {
+            std::size_t calls = 0;
+            // `storage` and `temporaries` bytes allocated in all calls
+            std::size_t allocated_bytes = 0;
+            // maximal increase of the live `storage` and `temporaries` bytes within one call
+            std::size_t peak_bytes = 0;
+        };
+
+        namespace impl_ {
+            struct counters {
+                std::atomic<std::size_t> live{0}, peak{0}, waste{0}, allocations{0}, allocated{0};
+            };
+
+            struct scope_state {
+                std::string name;
+                scope_state *parent;
+                std::size_t allocated;
+                long long live;
+                long long peak;
+            };
+
+            inline void escape(std::ostream &os, std::string const &src) {
+                os << '"';
+                for (char c : src) {
+                    if (c == '"' || c == '\\')
+                        os << '\\' << c;
+                    else if ((unsigned char)c < 0x20) {
+                        char buf[8];
+                        std::snprintf(buf, sizeof(buf), "\\u%04x", (unsigned char)c);
+                        os << buf;
+                    } else
+                        os << c;
+                }
+                os << '"';
+            }
+
+            struct registry {
+                counters m_counters[num_categories];
+                std::mutex m_mutex;
+                std::map<std::string, computation_stats> m_computations;
+            };
+
+            inline void dump_json(std::ostream &os, registry &registry);
+
+            struct report_at_exit {
+                registry &m_registry;
+
+                ~report_at_exit() {
+                    if (char const *path = std::getenv("GT_MEMORY_REPORT")) {
+                        std::ofstream os(path);
+                        dump_json(os, m_registry);
+                        if (!os)
+                            std::fprintf(stderr, "warning: failed to write GT_MEMORY_REPORT to '%s'\n", path);
+                    }
+                }
+            };
+
+            // never destroyed: data stores with static storage duration may be released after the report is written
+            inline registry &get_registry() {
+                static registry &res = *new registry;
+                static report_at_exit report = {res};
+                return res;
+            }
+
+            inline scope_state *&current_scope() {
+                static thread_local scope_state *res = nullptr;
+                return res;
+            }
+
+            inline void update_max(std::atomic<std::size_t> &dst, std::size_t value) {
+                auto cur = dst.load(std::memory_order_relaxed);
+                while (cur < value && !dst.compare_exchange_weak(cur, value, std::memory_order_relaxed))
+                    ;
+            }
+
+            inline bool is_attributed_to_computations(category c) {
+                return c == category::storage || c == category::temporaries;
+            }
+
+            inline void dump_json(std::ostream &os, registry &registry) {
+                os << "{\n  \"categories\": {";
+                for (int i = 0; i != num_categories; ++i) {
+                    auto const &counters = registry.m_counters[i];
+                    os << (i ? ",\n" : "\n") << "    \"" << name(category(i))
+                       << "\": {\"live_bytes\": " << counters.live << ", \"peak_bytes\": " << counters.peak
+                       << ", \"waste_bytes\": " << counters.waste << ", \"allocations\": " << counters.allocations
+                       << ", \"allocated_bytes\": " << counters.allocated << "}";
+                }
+                os << "\n  },\n  \"computations\": {";
+                std::lock_guard<std::mutex> lock(registry.m_mutex);
+                bool first = true;
+                for (auto const &[key, s] : registry.m_computations) {
+                    os << (first ? "\n" : ",\n") << "    ";
+                    escape(os, key);
+                    os << ": {\"calls\": " << s.calls << ", \"allocated_bytes\": " << s.allocated_bytes
+                       << ", \"peak_bytes\": " << s.peak_bytes << "}";
+                    first = false;
+                }
+                os << "\n  }\n}\n";
+            }
+        } // namespace impl_
+
+        /**
+         *  Accounts an allocation of `bytes` bytes, `waste` of which are not requested by the user.
+         */
+        inline void allocated(category c, std::size_t bytes, std::size_t waste = 0) {
+            auto &counters = impl_::get_registry().m_counters[(int)c];
+            counters.allocations.fetch_add(1, std::memory_order_relaxed);
+            counters.allocated.fetch_add(bytes, std::memory_order_relaxed);
+            counters.waste.fetch_add(waste, std::memory_order_relaxed);
+            impl_::update_max(counters.peak, counters.live.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+            if (impl_::is_attributed_to_computations(c))
+                for (auto *scope = impl_::current_scope(); scope; scope = scope->parent) {
+                    scope->allocated += bytes;
+                    scope->live += bytes;
+                    scope->peak = std::max(scope->peak, scope->live);
+                }
+        }
+
+        /**
+         *  Accounts the release of an allocation, the arguments are the ones passed to `allocated`.
+         */
+        inline void deallocated(category c, std::size_t bytes, std::size_t waste = 0) {
+            auto &counters = impl_::get_registry().m_counters[(int)c];
+            counters.live.fetch_sub(bytes, std::memory_order_relaxed);
+            counters.waste.fetch_sub(waste, std::memory_order_relaxed);
+            if (impl_::is_attributed_to_computations(c))
+                for (auto *scope = impl_::current_scope(); scope; scope = scope->parent)
+                    scope->live -= bytes;
+        }
+
+        /**
+         *  Accounts the allocations that are made through it, the total is released in the destructor.
+         */
+        class record {
+            category m_category;
+            std::size_t m_bytes = 0;
+            std::size_t m_waste = 0;
+
+          public:
+            explicit record(category c) : m_category(c) {}
+            record(category c, std::size_t bytes, std::size_t waste = 0) : m_category(c) { add(bytes, waste); }
+            record(record &&other) noexcept
+                : m_category(other.m_category), m_bytes(other.m_bytes), m_waste(other.m_waste) {
+                other.m_bytes = other.m_waste = 0;
+            }
+            record &operator=(record &&other) noexcept {
+                std::swap(m_category, other.m_category);
+                std::swap(m_bytes, other.m_bytes);
+                std::swap(m_waste, other.m_waste);
+                return *this;
+            }
+            ~record() {
+                if (m_bytes || m_waste)
+                    deallocated(m_category, m_bytes, m_waste);
+            }
+
+            void add(std::size_t bytes, std::size_t waste = 0) {
+                allocated(m_category, bytes, waste);
+                m_bytes += bytes;
+                m_waste += waste;
+            }
+        };
+
+        /**
+         *  While alive, the `storage` and `temporaries` allocations of the calling thread are attributed to the
+         *  computation `name`. Scopes can be nested, the allocations are attributed to all enclosing scopes.
+         */
+        class computation_scope {
+            impl_::scope_state m_state;
+
+          public:
+            explicit computation_scope(std::string name) : m_state{std::move(name), impl_::current_scope(), 0, 0, 0} {
+                impl_::current_scope() = &m_state;
+            }
+            computation_scope(computation_scope const &) = delete;
+            computation_scope &operator=(computation_scope const &) = delete;
+
+            ~computation_scope() {
+                impl_::current_scope() = m_state.parent;
+                auto &registry = impl_::get_registry();
+                std::lock_guard<std::mutex> lock(registry.m_mutex);
+                auto &dst = registry.m_computations[m_state.name];
+                ++dst.calls;
+                dst.allocated_bytes += m_state.allocated;
+                dst.peak_bytes = std::max(dst.peak_bytes, (std::size_t)m_state.peak);
+            }
+        };
+
+        inline stats get_stats(category c) {
+            auto const &counters = impl_::get_registry().m_counters[(int)c];
+            stats res;
+            res.live_bytes = counters.live.load(std::memory_order_relaxed);
+            res.peak_bytes = counters.peak.load(std::memory_order_relaxed);
+            res.waste_bytes = counters.waste.load(std::memory_order_relaxed);
+            res.allocations = counters.allocations.load(std::memory_order_relaxed);
+            res.allocated_bytes = counters.allocated.load(std::memory_order_relaxed);
+            return res;
+        }
+
+        inline std::map<std::string, computation_stats> get_computation_stats() {
+            auto &registry = impl_::get_registry();
+            std::lock_guard<std::mutex> lock(registry.m_mutex);
+            return registry.m_computations;
+        }
+
+        /**
+         *  Sets the peaks to the current live bytes and forgets the computation statistics.
+         */
+        inline void reset_peaks() {
+            auto &registry = impl_::get_registry();
+            for (auto &counters : registry.m_counters)
+                counters.peak.store(counters.live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(registry.m_mutex);
+            registry.m_computations.clear();
+        }
+
+        inline void dump_json(std::ostream &os) { impl_::dump_json(os, impl_::get_registry()); }
+
+        inline std::string to_json() {
+            std::ostringstream os;
+            dump_json(os);
+            return os.str();
+        }
+    } // namespace memory_accounting
+} // namespace gridtools
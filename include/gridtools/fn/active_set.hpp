@@ -0,0 +1,184 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gridtools::fn {
+    namespace active_set_impl_ {
+        /**
+         *  The active columns `[i_begin, i_end) x {j}`.
+         */
+        struct active_range {
+            int i_begin;
+            int i_end;
+            int j;
+
+            friend bool operator==(active_range const &lhs, active_range const &rhs) {
+                return lhs.i_begin == rhs.i_begin && lhs.i_end == rhs.i_end && lhs.j == rhs.j;
+            }
+        };
+
+        /**
+         *  A compact set of active (i, j) columns within an `i_size x j_size` horizontal domain.
+         *
+         *  The columns are stored as ranges of consecutive i indices, ordered by j and i, such that the loops over
+         *  one range access memory with unit stride along i. The ranges are grouped into chunks of (up to)
+         *  `chunk_size` columns, splitting the ranges at the chunk boundaries. The backends distribute the chunks
+         *  over the threads, so the work is balanced by the number of active columns instead of the area of the
+         *  domain.
+         *
+         *  Used with `cartesian_active_domain`, the set must outlive the backends and executors created from it.
+         */
+        class active_set {
+            int m_i_size;
+            int m_j_size;
+            std::size_t m_size = 0;
+            std::vector<active_range> m_ranges;
+            std::vector<std::size_t> m_chunks = {0};
+
+            void add_range(active_range range, int chunk_size) {
+                while (range.i_begin < range.i_end) {
+                    int in_chunk = int(m_size % chunk_size);
+                    int n = std::min(range.i_end - range.i_begin, chunk_size - in_chunk);
+                    m_ranges.push_back({range.i_begin, range.i_begin + n, range.j});
+                    range.i_begin += n;
+                    m_size += n;
+                    if (m_size % chunk_size == 0)
+                        m_chunks.push_back(m_ranges.size());
+                }
+            }
+
+            void init(std::vector<active_range> ranges, int chunk_size) {
+                assert(chunk_size > 0);
+                std::sort(ranges.begin(), ranges.end(), [](auto const &lhs, auto const &rhs) {
+                    return std::pair(lhs.j, lhs.i_begin) < std::pair(rhs.j, rhs.i_begin);
+                });
+                // merge overlapping and adjacent ranges
+                std::vector<active_range> merged;
+                for (auto const &range : ranges) {
+                    assert(range.j >= 0 && range.j < m_j_size);
+                    assert(range.i_begin >= 0 && range.i_end <= m_i_size);
+                    if (range.i_begin >= range.i_end)
+                        continue;
+                    if (!merged.empty() && merged.back().j == range.j && merged.back().i_end >= range.i_begin)
+                        merged.back().i_end = std::max(merged.back().i_end, range.i_end);
+                    else
+                        merged.push_back(range);
+                }
+                for (auto const &range : merged)
+                    add_range(range, chunk_size);
+                if (m_chunks.back() != m_ranges.size())
+                    m_chunks.push_back(m_ranges.size());
+            }
+
+          public:
+            static constexpr int default_chunk_size = 1024;
+
+            /**
+             *  The columns are given as (possibly overlapping) ranges.
+             */
+            active_set(
+                int i_size, int j_size, std::vector<active_range> ranges, int chunk_size = default_chunk_size)
+                : m_i_size(i_size), m_j_size(j_size) {
+                init(std::move(ranges), chunk_size);
+            }
+
+            /**
+             *  The columns are given as a list of (i, j) pairs in any order, duplicates are ignored.
+             */
+            active_set(int i_size,
+                int j_size,
+                std::vector<std::array<int, 2>> const &columns,
+                int chunk_size = default_chunk_size)
+                : m_i_size(i_size), m_j_size(j_size) {
+                std::vector<active_range> ranges;
+                ranges.reserve(columns.size());
+                for (auto const &[i, j] : columns)
+                    ranges.push_back({i, i + 1, j});
+                init(std::move(ranges), chunk_size);
+            }
+
+            /**
+             *  The columns where `mask(i, j)` is true.
+             */
+            template <class Mask,
+                std::enable_if_t<std::is_convertible_v<std::invoke_result_t<Mask const &, int, int>, bool>, int> = 0>
+            active_set(int i_size, int j_size, Mask const &mask, int chunk_size = default_chunk_size)
+                : m_i_size(i_size), m_j_size(j_size) {
+                std::vector<active_range> ranges;
+                for (int j = 0; j < j_size; ++j)
+                    for (int i = 0; i < i_size;) {
+                        for (; i < i_size && !mask(i, j); ++i)
+                            ;
+                        int i_begin = i;
+                        for (; i < i_size && mask(i, j); ++i)
+                            ;
+                        if (i_begin < i)
+                            ranges.push_back({i_begin, i, j});
+                    }
+                init(std::move(ranges), chunk_size);
+            }
+
+            int i_size() const { return m_i_size; }
+            int j_size() const { return m_j_size; }
+
+            // number of active columns
+            std::size_t size() const { return m_size; }
+
+            std::vector<active_range> const &ranges() const { return m_ranges; }
+
+            std::size_t num_chunks() const { return m_chunks.size() - 1; }
+
+            // the ranges of the chunk `c`
+            std::pair<active_range const *, active_range const *> chunk(std::size_t c) const {
+                assert(c < num_chunks());
+                return {m_ranges.data() + m_chunks[c], m_ranges.data() + m_chunks[c + 1]};
+            }
+
+            /**
+             *  The columns `(i + di, j + dj)` with `-i_minus <= di <= i_plus` and `-j_minus <= dj <= j_plus` of all
+             *  the active columns `(i, j)`, clipped to the domain. These are the columns a stage has to compute if
+             *  another stage reads its result on the active columns with horizontal shifts within that range.
+             */
+            active_set dilated(
+                int i_minus, int i_plus, int j_minus, int j_plus, int chunk_size = default_chunk_size) const {
+                assert(i_minus >= 0 && i_plus >= 0 && j_minus >= 0 && j_plus >= 0);
+                std::vector<active_range> ranges;
+                ranges.reserve(m_ranges.size() * (j_minus + j_plus + 1));
+                for (auto const &range : m_ranges)
+                    for (int j = std::max(range.j - j_minus, 0); j < std::min(range.j + j_plus + 1, m_j_size); ++j)
+                        ranges.push_back(
+                            {std::max(range.i_begin - i_minus, 0), std::min(range.i_end + i_plus, m_i_size), j});
+                return {m_i_size, m_j_size, std::move(ranges), chunk_size};
+            }
+        };
+
+        /**
+         *  The sizes of a domain restricted to the columns of an `active_set` along the dimensions `I` and `J`.
+         *  Backends that support sparse execution overload their stage functions for it.
+         */
+        template <class I, class J, class Sizes>
+        struct active_sizes {
+            Sizes m_sizes;
+            active_set const *m_set;
+        };
+    } // namespace active_set_impl_
+
+    using active_set_impl_::active_range;
+    using active_set_impl_::active_set;
+    using active_set_impl_::active_sizes;
+} // namespace gridtools::fn
@@ -20,6 +20,7 @@
 #include "../../thread_pool/concept.hpp"
 #include "../../thread_pool/dummy.hpp"
 #include "../../thread_pool/omp.hpp"
+#include "../active_set.hpp"
 #include "./common.hpp"
 
 namespace gridtools::fn::backend {
@@ -52,6 +53,31 @@ namespace gridtools::fn::backend {
             };
         }
 
+        // `f(ptr, strides)` is called for all active columns (and the indices of the dimensions other than `I` and
+        // `J` in `Rest`), the chunks of the set are distributed over the threads
+        template <class ThreadPool, class I, class J, class Sizes, class Rest>
+        auto make_active_loops(ThreadPool, active_sizes<I, J, Sizes> const &sizes, Rest const &rest) {
+            return [=](auto f) {
+                return [=](auto const &ptr, auto const &strides) {
+                    auto &&set = *sizes.m_set;
+                    auto &&i_stride = sid::get_stride<I>(strides);
+                    auto &&j_stride = sid::get_stride<J>(strides);
+                    auto loop_f = [&](std::size_t chunk) {
+                        auto [first, last] = set.chunk(chunk);
+                        for (auto range = first; range != last; ++range) {
+                            auto local_ptr = ptr;
+                            sid::shift(local_ptr, i_stride, range->i_begin);
+                            sid::shift(local_ptr, j_stride, range->j);
+                            // the unit stride i loop is the innermost one
+                            common::make_loops(rest)(sid::make_loop<I>(range->i_end - range->i_begin)(f))(
+                                local_ptr, strides);
+                        }
+                    };
+                    thread_pool::parallel_for_loop(ThreadPool(), loop_f, set.num_chunks());
+                };
+            };
+        }
+
         template <class ThreadPool, class Sizes, class StencilStage, class MakeIterator, class Composite>
         void apply_stencil_stage(naive_with_threadpool<ThreadPool>,
             Sizes const &sizes,
@@ -88,6 +114,55 @@ namespace gridtools::fn::backend {
                 ptr, strides);
         }
 
+        template <class ThreadPool,
+            class I,
+            class J,
+            class Sizes,
+            class StencilStage,
+            class MakeIterator,
+            class Composite>
+        void apply_stencil_stage(naive_with_threadpool<ThreadPool>,
+            active_sizes<I, J, Sizes> const &sizes,
+            StencilStage,
+            MakeIterator &&make_iterator,
+            Composite &&composite) {
+            auto ptr = sid::get_origin(std::forward<Composite>(composite))();
+            auto strides = sid::get_strides(std::forward<Composite>(composite));
+            auto rest = hymap::canonicalize_and_remove_key<J>(hymap::canonicalize_and_remove_key<I>(sizes.m_sizes));
+            make_active_loops(ThreadPool(), sizes, rest)(
+                [make_iterator = make_iterator()](auto &ptr, auto const &strides) {
+                    StencilStage()(make_iterator, ptr, strides);
+                })(ptr, strides);
+        }
+
+        template <class ThreadPool,
+            class I,
+            class J,
+            class Sizes,
+            class ColumnStage,
+            class MakeIterator,
+            class Composite,
+            class Vertical,
+            class Seed>
+        void apply_column_stage(naive_with_threadpool<ThreadPool>,
+            active_sizes<I, J, Sizes> const &sizes,
+            ColumnStage,
+            MakeIterator &&make_iterator,
+            Composite &&composite,
+            Vertical,
+            Seed seed) {
+            auto ptr = sid::get_origin(std::forward<Composite>(composite))();
+            auto strides = sid::get_strides(std::forward<Composite>(composite));
+            auto v_size = at_key<Vertical>(sizes.m_sizes);
+            auto rest = hymap::canonicalize_and_remove_key<Vertical>(
+                hymap::canonicalize_and_remove_key<J>(hymap::canonicalize_and_remove_key<I>(sizes.m_sizes)));
+            make_active_loops(ThreadPool(), sizes, rest)(
+                [v_size = std::move(v_size), make_iterator = make_iterator(), seed = std::move(seed)](
+                    auto ptr, auto const &strides) {
+                    ColumnStage()(seed, v_size, make_iterator, std::move(ptr), strides);
+                })(ptr, strides);
+        }
+
         template <class ThreadPool>
         inline auto tmp_allocator(naive_with_threadpool<ThreadPool> be) {
             return std::make_tuple(be, sid::allocator(&std::make_unique<char[]>));
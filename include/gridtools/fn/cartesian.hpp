@@ -9,11 +9,13 @@
  */
 #pragma once
 
+#include <cassert>
 #include <functional>
 
 #include "../common/const_ptr_deref.hpp"
 #include "../common/tuple_util.hpp"
 #include "../sid/concept.hpp"
+#include "./active_set.hpp"
 #include "./common_interface.hpp"
 #include "./executor.hpp"
 
@@ -37,6 +39,31 @@ namespace gridtools::fn {
             Sizes const &sizes() const { return m_sizes; }
         };
 
+        /**
+         *  A cartesian domain, where the stages only run on the (i, j) columns of `set`. The indices of the set are
+         *  relative to `offsets`, its horizontal size must match `sizes`. `sizes()` are the dense sizes, that are
+         *  used to allocate the temporaries.
+         *
+         *  All the stages of an executor run on the same set. If a stage reads the result of a previous stage (e.g. a
+         *  temporary) with horizontal shifts, the set must contain the columns of the wanted output dilated by these
+         *  shifts, accumulated over the chain of stages, see `active_set::dilated`. Otherwise the shifted reads see
+         *  values that were not computed.
+         */
+        template <class Sizes, class Offsets = std::tuple<>>
+        struct cartesian_active_domain {
+            active_sizes<dim::i, dim::j, Sizes> m_sizes;
+            Offsets m_offsets;
+
+            cartesian_active_domain(Sizes const &sizes, active_set const &set, Offsets const &offsets = {})
+                : m_sizes{sizes, &set}, m_offsets(offsets) {
+                assert(set.i_size() == int(host_device::at_key<dim::i>(sizes)));
+                assert(set.j_size() == int(host_device::at_key<dim::j>(sizes)));
+            }
+
+            Sizes const &sizes() const { return m_sizes.m_sizes; }
+            active_set const &set() const { return *m_sizes.m_set; }
+        };
+
         template <class Tag, class Ptr, class Strides>
         struct iterator {
             Ptr m_ptr;
@@ -97,7 +124,15 @@ namespace gridtools::fn {
             auto allocator = tmp_allocator(Backend());
             return backend<Backend, cartesian_domain<Sizes, Offsets>, decltype(allocator)>{b, d, std::move(allocator)};
         }
+
+        template <class Backend, class Sizes, class Offsets>
+        auto make_backend(Backend const &b, cartesian_active_domain<Sizes, Offsets> const &d) {
+            auto allocator = tmp_allocator(Backend());
+            return backend<Backend, cartesian_active_domain<Sizes, Offsets>, decltype(allocator)>{
+                b, d, std::move(allocator)};
+        }
     } // namespace cartesian_impl_
+    using cartesian_impl_::cartesian_active_domain;
     using cartesian_impl_::cartesian_domain;
     using cartesian_impl_::deref;
     using cartesian_impl_::make_backend;
@@ -0,0 +1,122 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "../common/array.hpp"
+#include "../common/const_ptr_deref.hpp"
+#include "../common/defs.hpp"
+#include "../common/integral_constant.hpp"
+#include "../common/tuple_util.hpp"
+#include "../sid/as_const.hpp"
+#include "../sid/concept.hpp"
+
+/**
+ *   Compressed sparse row (CSR) neighbor tables for variable-valence meshes.
+ *
+ *   Instead of a dense `[index][MaxNumNeighbors]` table padded with `-1`, the neighbors are stored in two
+ *   one-dimensional SIDs:
+ *     - `offsets` of size `n + 1`, where the neighbors of `index` are stored in `[offsets[index], offsets[index + 1])`;
+ *     - `indices` of size `offsets[n]`, containing the neighbor indices without any padding.
+ *
+ *   The table models the neighbor table concept: `neighbor_table::neighbors` returns an array of size
+ *   `MaxNumNeighbors` padded with `-1`, so CSR tables can be used everywhere dense tables can. Additionally,
+ *   `neighbor_table::for_each_neighbor` only visits the stored neighbors, without any `-1` checks.
+ *
+ *   The stored neighbors occupy the leading slots of the padded list, so the `local_index` passed by
+ *   `for_each_neighbor` is the position of the neighbor in `neighbor_table::neighbors`, as for dense tables.
+ *   The valence of every row must not exceed `MaxNumNeighbors`, this is checked with `assert` only.
+ */
+
+namespace gridtools::fn::csr_neighbor_table {
+    namespace csr_neighbor_table_impl_ {
+        template <class Dim,
+            std::size_t MaxNumNeighbors,
+            class OffsetsPtrHolder,
+            class OffsetsStrides,
+            class IndicesPtrHolder,
+            class IndicesStrides>
+        struct csr_neighbor_table {
+            OffsetsPtrHolder offsets_origin;
+            OffsetsStrides offsets_strides;
+            IndicesPtrHolder indices_origin;
+            IndicesStrides indices_strides;
+        };
+
+        template <class Dim, std::size_t MaxNumNeighbors, class... Ts>
+        GT_FUNCTION int first_neighbor(csr_neighbor_table<Dim, MaxNumNeighbors, Ts...> const &table, int index) {
+            auto ptr = table.offsets_origin();
+            sid::shift(ptr, sid::get_stride<Dim>(table.offsets_strides), index);
+            return const_ptr_deref(ptr);
+        }
+
+        template <class Dim, std::size_t MaxNumNeighbors, class... Ts>
+        GT_FUNCTION int num_neighbors(csr_neighbor_table<Dim, MaxNumNeighbors, Ts...> const &table, int index) {
+            return first_neighbor(table, index + 1) - first_neighbor(table, index);
+        }
+
+        template <class Dim, std::size_t MaxNumNeighbors, class... Ts, class F>
+        GT_FUNCTION void neighbor_table_for_each_neighbor(
+            csr_neighbor_table<Dim, MaxNumNeighbors, Ts...> const &table, int index, F &&f) {
+            int first = first_neighbor(table, index);
+            int n = first_neighbor(table, index + 1) - first;
+            assert(n >= 0 && n <= int(MaxNumNeighbors));
+            auto ptr = table.indices_origin();
+            auto const &stride = sid::get_stride<Dim>(table.indices_strides);
+            sid::shift(ptr, stride, first);
+            for (int local_index = 0; local_index < n; ++local_index) {
+                f(local_index, int(const_ptr_deref(ptr)));
+                sid::shift(ptr, stride, integral_constant<int, 1>());
+            }
+        }
+
+        template <class Dim, std::size_t MaxNumNeighbors, class... Ts>
+        GT_FUNCTION auto neighbor_table_neighbors(
+            csr_neighbor_table<Dim, MaxNumNeighbors, Ts...> const &table, int index) {
+            using element_type = std::decay_t<decltype(*table.indices_origin())>;
+            gridtools::array<element_type, MaxNumNeighbors> neighbors;
+            for (std::size_t i = 0; i < MaxNumNeighbors; ++i)
+                neighbors[i] = -1;
+            neighbor_table_for_each_neighbor(
+                table, index, [&](int local_index, int neighbor) { neighbors[local_index] = neighbor; });
+            return neighbors;
+        }
+
+        template <class Dim, std::size_t MaxNumNeighbors, class OffsetsSid, class IndicesSid>
+        auto as_neighbor_table(OffsetsSid &&offsets, IndicesSid &&indices) {
+            static_assert(tuple_util::size<decltype(sid::get_strides(std::declval<OffsetsSid>()))>::value == 1,
+                "CSR offsets must have exactly one dimension");
+            static_assert(tuple_util::size<decltype(sid::get_strides(std::declval<IndicesSid>()))>::value == 1,
+                "CSR indices must have exactly one dimension");
+
+            decltype(auto) const_offsets = sid::as_const(std::forward<OffsetsSid>(offsets));
+            decltype(auto) const_indices = sid::as_const(std::forward<IndicesSid>(indices));
+            auto const offsets_origin = sid::get_origin(const_offsets);
+            auto const offsets_strides = sid::get_strides(const_offsets);
+            auto const indices_origin = sid::get_origin(const_indices);
+            auto const indices_strides = sid::get_strides(const_indices);
+
+            return csr_neighbor_table<Dim,
+                MaxNumNeighbors,
+                decltype(offsets_origin),
+                decltype(offsets_strides),
+                decltype(indices_origin),
+                decltype(indices_strides)>{offsets_origin, offsets_strides, indices_origin, indices_strides};
+        }
+    } // namespace csr_neighbor_table_impl_
+
+    using csr_neighbor_table_impl_::as_neighbor_table;
+    using csr_neighbor_table_impl_::num_neighbors;
+
+} // namespace gridtools::fn::csr_neighbor_table
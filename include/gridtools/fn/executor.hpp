@@ -11,6 +11,9 @@
 
 #include <tuple>
 
+#include "../common/defs.hpp"
+#include "../common/host_device.hpp"
+#include "../common/integral_constant.hpp"
 #include "../common/tuple_util.hpp"
 #include "../meta.hpp"
 #include "../sid/sid_shift_origin.hpp"
@@ -20,13 +23,28 @@
 
 namespace gridtools::fn {
     namespace executor_impl_ {
+        struct transient_ptr_diff {};
+
+        // Placeholder SID for transient args. Models SID concept, but is never dereferenced.
+        struct transient_placeholder {
+            GT_FUNCTION constexpr transient_placeholder operator()() const { return {}; }
+            GT_FUNCTION constexpr transient_placeholder operator*() const { return {}; }
+
+            friend GT_FUNCTION constexpr transient_placeholder operator+(transient_placeholder, transient_ptr_diff) {
+                return {};
+            }
+            friend constexpr transient_placeholder sid_get_origin(transient_placeholder const &) { return {}; }
+            friend constexpr transient_ptr_diff sid_get_ptr_diff(transient_placeholder) { return {}; }
+        };
+
         template <class Backend,
             int ArgOffset,
             class Sizes,
             class Offsets,
             class MakeIterator,
             class Args = std::tuple<>,
-            class Specs = meta::list<>>
+            class Specs = meta::list<>,
+            class Transients = meta::list<>>
         struct executor_data {
             Backend m_backend;
             Sizes m_sizes;
@@ -35,13 +53,38 @@ namespace gridtools::fn {
             Args m_args = {};
             using arg_offset_t = std::integral_constant<int, ArgOffset>;
             using specs_t = Specs;
+            using transients_t = Transients;
 
             template <class Arg>
             auto arg(Arg &&arg) && {
                 auto args = tuple_util::deep_copy(
                     tuple_util::push_back(std::move(m_args), sid::shift_sid_origin(std::forward<Arg>(arg), m_offsets)));
-                return executor_data<Backend, ArgOffset, Sizes, Offsets, MakeIterator, decltype(args), Specs>{
-                    std::move(m_backend),
+                return executor_data<Backend,
+                    ArgOffset,
+                    Sizes,
+                    Offsets,
+                    MakeIterator,
+                    decltype(args),
+                    Specs,
+                    Transients>{std::move(m_backend),
+                    std::move(m_sizes),
+                    std::move(m_offsets),
+                    std::move(m_make_iterator),
+                    std::move(args)};
+            }
+
+            // transient args are not backed by memory, the placeholder keeps the numbering of the args intact
+            auto transient_arg() && {
+                using transients_t = meta::push_back<Transients, integral_constant<int, std::tuple_size_v<Args>>>;
+                auto args = tuple_util::push_back(std::move(m_args), transient_placeholder());
+                return executor_data<Backend,
+                    ArgOffset,
+                    Sizes,
+                    Offsets,
+                    MakeIterator,
+                    decltype(args),
+                    Specs,
+                    transients_t>{std::move(m_backend),
                     std::move(m_sizes),
                     std::move(m_offsets),
                     std::move(m_make_iterator),
@@ -51,7 +94,7 @@ namespace gridtools::fn {
             template <class Spec>
             auto spec(Spec) && {
                 using specs_t = meta::push_back<Specs, Spec>;
-                return executor_data<Backend, ArgOffset, Sizes, Offsets, MakeIterator, Args, specs_t>{
+                return executor_data<Backend, ArgOffset, Sizes, Offsets, MakeIterator, Args, specs_t, Transients>{
                     std::move(m_backend),
                     std::move(m_sizes),
                     std::move(m_offsets),
@@ -60,27 +103,95 @@ namespace gridtools::fn {
             }
         };
 
-        template <class Data>
+        /**
+         *  Result of `stencil_executor::prepare()`.
+         *
+         *  Owns the arguments and holds the composite with its origin and strides precomputed. `execute()` can be
+         *  called repeatedly and skips all argument setup; only the stencil stages themselves are run.
+         */
+        template <class Backend, class Specs, class MakeIterator, class Sizes, class Composite, bool MergeStages>
+        struct prepared_stencil_executor {
+            Backend m_backend;
+            MakeIterator m_make_iterator;
+            Sizes m_sizes;
+            Composite m_composite;
+
+            void execute() {
+                apply_stencil_stages<MergeStages>(m_backend, Specs(), m_make_iterator, m_sizes, m_composite);
+            }
+        };
+
+        template <class Vertical,
+            class Backend,
+            class Specs,
+            class MakeIterator,
+            class Sizes,
+            class Composite,
+            class Seeds>
+        struct prepared_vertical_executor {
+            Backend m_backend;
+            MakeIterator m_make_iterator;
+            Sizes m_sizes;
+            Composite m_composite;
+            Seeds m_seeds;
+
+            void execute() {
+                apply_column_stages(m_backend, Specs(), m_make_iterator, m_sizes, Vertical(), m_composite, m_seeds);
+            }
+        };
+
+        template <class Data, bool MergeStages = false>
         struct stencil_executor {
             Data m_data;
 
             template <class Arg>
             auto arg(Arg &&arg) && {
                 auto data = std::move(m_data).arg(std::forward<Arg>(arg));
-                return stencil_executor<decltype(data)>{std::move(data)};
+                return stencil_executor<decltype(data), MergeStages>{std::move(data)};
+            }
+
+            /**
+             *  Adds a transient argument: an intermediate result that is only read by later stages of this executor.
+             *  Transient arguments are not backed by memory: the stage that writes them is inlined into the stages
+             *  that read them, recomputing the value on the fly (including all shifts).
+             */
+            auto transient() && {
+                auto data = std::move(m_data).transient_arg();
+                return stencil_executor<decltype(data), MergeStages>{std::move(data)};
             }
 
+            /**
+             *  Opts in to the fusion of independent stages into a single parallel loop (see `schedule_stencil_stages`).
+             *  The dependencies are derived from the argument indices only, so the caller must guarantee that no
+             *  two arguments alias each other (e.g. the same SID passed to `arg` twice, once read and once written).
+             *  By default the stages are executed in the order of the `assign` calls.
+             */
+            auto merge_independent_stages() && { return stencil_executor<Data, true>{std::move(m_data)}; }
+
             template <class Out, class Stencil, class... Ins>
             auto assign(Out, Stencil, Ins...) && {
                 auto data = std::move(m_data).spec(stencil_stage<Stencil,
                     Out::value + Data::arg_offset_t::value,
                     Ins::value + Data::arg_offset_t::value...>());
-                return stencil_executor<decltype(data)>{std::move(data)};
+                return stencil_executor<decltype(data), MergeStages>{std::move(data)};
+            }
+
+            auto prepare() && {
+                auto composite = make_prepared_composite(std::move(m_data.m_args));
+                return prepared_stencil_executor<decltype(m_data.m_backend),
+                    inline_transients<typename Data::specs_t, typename Data::transients_t>,
+                    decltype(m_data.m_make_iterator),
+                    decltype(m_data.m_sizes),
+                    decltype(composite),
+                    MergeStages>{std::move(m_data.m_backend),
+                    std::move(m_data.m_make_iterator),
+                    std::move(m_data.m_sizes),
+                    std::move(composite)};
             }
 
             void execute() && {
-                run_stencil_stages(std::move(m_data.m_backend),
-                    typename Data::specs_t(),
+                run_stencil_stages<MergeStages>(std::move(m_data.m_backend),
+                    inline_transients<typename Data::specs_t, typename Data::transients_t>(),
                     std::move(m_data.m_make_iterator),
                     std::move(m_data.m_sizes),
                     std::move(m_data.m_args));
@@ -108,6 +219,21 @@ namespace gridtools::fn {
                 return vertical_executor<Vertical, decltype(data), decltype(seeds)>{std::move(data), std::move(seeds)};
             }
 
+            auto prepare() && {
+                auto composite = make_prepared_composite(std::move(m_data.m_args));
+                return prepared_vertical_executor<Vertical,
+                    decltype(m_data.m_backend),
+                    typename Data::specs_t,
+                    decltype(m_data.m_make_iterator),
+                    decltype(m_data.m_sizes),
+                    decltype(composite),
+                    Seeds>{std::move(m_data.m_backend),
+                    std::move(m_data.m_make_iterator),
+                    std::move(m_data.m_sizes),
+                    std::move(composite),
+                    std::move(m_seeds)};
+            }
+
             void execute() && {
                 run_column_stages(std::move(m_data.m_backend),
                     typename Data::specs_t(),
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <type_traits>
+#include <utility>
 
 #include "../common/const_ptr_deref.hpp"
 #include "../common/tuple_util.hpp"
@@ -28,6 +29,14 @@
  *
  *   Pure functional behavior without side-effects is expected from the provided function.
  *
+ *   Optionally, a neighbor table can provide a function to visit only its valid neighbors:
+ *     `void neighbor_table_for_each_neighbor(T const&, int, F&& f);`
+ *   which calls `f(int local_index, int neighbor)` for every neighbor that is not `-1`. This is useful for
+ *   variable-valence tables, where the neighbor list returned by `neighbor_table_neighbors` has to be padded.
+ *   `local_index` is the position of `neighbor` in the list returned by `neighbor_table_neighbors` (the slot),
+ *   not the number of valid neighbors visited before. E.g. for the padded list `{1, -1, 2}` `f` is called with
+ *   `(0, 1)` and `(2, 2)`.
+ *
  *   Compile-time API
  *   ================
  *
@@ -40,6 +49,10 @@
  *
  *   `Neighbors neighbor_table::neighbors(NeighborTable const&, int);`
  *
+ *   Visit all valid (non-`-1`) neighbors, either via `neighbor_table_for_each_neighbor` or via the padded list:
+ *
+ *   `void neighbor_table::for_each_neighbor(NeighborTable const&, int, F&&);`
+ *
  *   Default Implementation
  *   ======================
  *
@@ -66,6 +79,23 @@ namespace gridtools::fn::neighbor_table {
             return neighbor_table_neighbors(nt, index);
         }
 
+        template <class NeighborTable, class F>
+        GT_FUNCTION constexpr void neighbor_table_for_each_neighbor(NeighborTable const &nt, int index, F &&f) {
+            int local_index = 0;
+            tuple_util::host_device::for_each(
+                [&](auto neighbor) {
+                    if (neighbor != -1)
+                        f(local_index, int(neighbor));
+                    ++local_index;
+                },
+                neighbors(nt, index));
+        }
+
+        template <class NeighborTable, class F>
+        GT_FUNCTION constexpr void for_each_neighbor(NeighborTable const &nt, int index, F &&f) {
+            neighbor_table_for_each_neighbor(nt, index, std::forward<F>(f));
+        }
+
         template <class T>
         using neighbor_list_type = std::remove_cv_t<std::remove_reference_t<
             decltype(::gridtools::fn::neighbor_table::neighbor_table_impl_::neighbors(std::declval<T const &>(), 0))>>;
@@ -79,6 +109,7 @@ namespace gridtools::fn::neighbor_table {
 
     } // namespace neighbor_table_impl_
 
+    using neighbor_table_impl_::for_each_neighbor;
     using neighbor_table_impl_::is_neighbor_table;
     using neighbor_table_impl_::neighbors;
 
@@ -12,6 +12,8 @@
 #include "../common/tuple_util.hpp"
 #include "../meta.hpp"
 #include "../sid/composite.hpp"
+#include "../sid/concept.hpp"
+#include "../sid/delegate.hpp"
 #include "./stencil_stage.hpp"
 
 namespace gridtools::fn {
@@ -24,13 +26,74 @@ namespace gridtools::fn {
             return tuple_util::convert_to<keys_t::template values>(std::forward<Sids>(sids));
         }
 
-        template <class Backend, class StageSpecs, class MakeIterator, class Domain, class Sids>
-        void run_stencil_stages(
-            Backend const &backend, StageSpecs, MakeIterator const &make_iterator, Domain const &domain, Sids &&sids) {
+        /**
+         *  A composite SID with precomputed origin and strides.
+         *
+         *  Used by prepared executors: the composite is built once and `get_origin`/`get_strides` just return the
+         *  cached values on every execution.
+         */
+        template <class Composite>
+        class prepared_composite : public sid::delegate<Composite> {
+            sid::ptr_holder_type<Composite> m_origin;
+            sid::strides_type<Composite> m_strides;
+
+            friend sid::ptr_holder_type<Composite> sid_get_origin(prepared_composite const &obj) {
+                return obj.m_origin;
+            }
+            friend sid::strides_type<Composite> const &sid_get_strides(prepared_composite const &obj) {
+                return obj.m_strides;
+            }
+
+          public:
+            prepared_composite(Composite composite)
+                : sid::delegate<Composite>(std::move(composite)), m_origin(sid::get_origin(this->m_impl)),
+                  m_strides(sid::get_strides(this->m_impl)) {}
+        };
+
+        template <class Sids>
+        auto make_prepared_composite(Sids &&sids) {
             auto composite = make_composite(std::forward<Sids>(sids));
+            return prepared_composite<decltype(composite)>(std::move(composite));
+        }
+
+        template <class StageSpecs, bool MergeStages>
+        struct scheduled_stages {
+            using type = meta::rename<std::tuple, StageSpecs>;
+        };
+
+        template <class StageSpecs>
+        struct scheduled_stages<StageSpecs, true> {
+            using type = meta::rename<std::tuple, schedule_stencil_stages<StageSpecs>>;
+        };
+
+        // if `MergeStages` is set, independent stages are fused to run within the same parallel loop, the arguments
+        // must not alias in this case
+        template <bool MergeStages = false,
+            class Backend,
+            class StageSpecs,
+            class MakeIterator,
+            class Domain,
+            class Composite>
+        void apply_stencil_stages(Backend const &backend,
+            StageSpecs,
+            MakeIterator const &make_iterator,
+            Domain const &domain,
+            Composite &composite) {
             tuple_util::for_each(
                 [&](auto stage) { apply_stencil_stage(backend, domain, std::move(stage), make_iterator, composite); },
-                meta::rename<std::tuple, StageSpecs>());
+                typename scheduled_stages<StageSpecs, MergeStages>::type());
+        }
+
+        template <bool MergeStages = false,
+            class Backend,
+            class StageSpecs,
+            class MakeIterator,
+            class Domain,
+            class Sids>
+        void run_stencil_stages(
+            Backend const &backend, StageSpecs, MakeIterator const &make_iterator, Domain const &domain, Sids &&sids) {
+            auto composite = make_composite(std::forward<Sids>(sids));
+            apply_stencil_stages<MergeStages>(backend, StageSpecs(), make_iterator, domain, composite);
         }
 
         template <class Backend,
@@ -38,16 +101,15 @@ namespace gridtools::fn {
             class MakeIterator,
             class Domain,
             class Vertical,
-            class Sids,
+            class Composite,
             class Seeds>
-        void run_column_stages(Backend const &backend,
+        void apply_column_stages(Backend const &backend,
             StageSpecs,
             MakeIterator const &make_iterator,
             Domain const &domain,
             Vertical,
-            Sids &&sids,
+            Composite &composite,
             Seeds &&seeds) {
-            auto composite = make_composite(std::forward<Sids>(sids));
             tuple_util::for_each(
                 [&](auto stage, auto seed) {
                     apply_column_stage(
@@ -56,8 +118,30 @@ namespace gridtools::fn {
                 meta::rename<std::tuple, StageSpecs>(),
                 std::forward<Seeds>(seeds));
         }
+
+        template <class Backend,
+            class StageSpecs,
+            class MakeIterator,
+            class Domain,
+            class Vertical,
+            class Sids,
+            class Seeds>
+        void run_column_stages(Backend const &backend,
+            StageSpecs,
+            MakeIterator const &make_iterator,
+            Domain const &domain,
+            Vertical,
+            Sids &&sids,
+            Seeds &&seeds) {
+            auto composite = make_composite(std::forward<Sids>(sids));
+            apply_column_stages(
+                backend, StageSpecs(), make_iterator, domain, Vertical(), composite, std::forward<Seeds>(seeds));
+        }
     } // namespace run_impl_
 
+    using run_impl_::apply_column_stages;
+    using run_impl_::apply_stencil_stages;
+    using run_impl_::make_prepared_composite;
     using run_impl_::run_column_stages;
     using run_impl_::run_stencil_stages;
 } // namespace gridtools::fn
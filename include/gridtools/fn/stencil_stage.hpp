@@ -9,9 +9,15 @@
  */
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
 #include "../common/hymap.hpp"
 #include "../common/integral_constant.hpp"
+#include "../common/tuple.hpp"
 #include "../common/tuple_util.hpp"
+#include "../meta.hpp"
 
 namespace gridtools::fn {
 
@@ -32,4 +38,260 @@ namespace gridtools::fn {
         }
     };
 
+    /**
+     *  Argument specification of an `inlined_stencil_stage`: the argument is not read from memory but computed on
+     *  the fly by applying `Stencil` to `Args`, where each of `Args` is either `integral_constant<int, I>` (the
+     *  argument `I` of the executor) or again a `lifted_arg`.
+     */
+    template <class Stencil, class... Args>
+    struct lifted_arg {};
+
+    namespace stencil_stage_impl_ {
+        template <class Stencil, class... Its>
+        struct lifted_iterator {
+            tuple<Its...> m_its;
+        };
+
+        template <class Stencil, class... Its>
+        GT_FUNCTION auto deref(lifted_iterator<Stencil, Its...> const &it) {
+            return tuple_util::host_device::apply(Stencil()(), it.m_its);
+        }
+
+        template <class Stencil, class... Its>
+        GT_FUNCTION bool can_deref(lifted_iterator<Stencil, Its...> const &it) {
+            return tuple_util::host_device::apply([](auto const &...its) { return (... && can_deref(its)); }, it.m_its);
+        }
+
+        template <class Stencil, class... Its, class... Offsets>
+        GT_FUNCTION auto shift(lifted_iterator<Stencil, Its...> const &it, Offsets... offsets) {
+            return tuple_util::host_device::apply(
+                [&](auto const &...its) {
+                    return lifted_iterator<Stencil, decltype(shift(its, offsets...))...>{{shift(its, offsets...)...}};
+                },
+                it.m_its);
+        }
+
+        template <int I, class MakeIterator, class Ptr, class Strides>
+        GT_FUNCTION auto make_arg(
+            integral_constant<int, I> arg, MakeIterator &&make_iterator, Ptr &ptr, Strides const &strides) {
+            return make_iterator(arg, ptr, strides);
+        }
+
+        template <class Stencil, class... Args, class MakeIterator, class Ptr, class Strides>
+        GT_FUNCTION auto make_arg(
+            lifted_arg<Stencil, Args...>, MakeIterator &&make_iterator, Ptr &ptr, Strides const &strides) {
+            return lifted_iterator<Stencil, decltype(make_arg(Args(), make_iterator, ptr, strides))...>{
+                {make_arg(Args(), make_iterator, ptr, strides)...}};
+        }
+    } // namespace stencil_stage_impl_
+
+    /**
+     *  Like `stencil_stage`, but some of the arguments might be `lifted_arg`s, that are recomputed on the fly
+     *  (including their shifts) instead of being read from memory.
+     */
+    template <class Stencil, int Out, class... Args>
+    struct inlined_stencil_stage {
+        template <class MakeIterator, class Ptr, class Strides>
+        GT_FUNCTION void operator()(MakeIterator &&make_iterator, Ptr &ptr, Strides const &strides) const {
+            *host_device::at_key<integral_constant<int, Out>>(ptr) =
+                Stencil()()(stencil_stage_impl_::make_arg(Args(), make_iterator, ptr, strides)...);
+        }
+    };
+
+    namespace stencil_stage_impl_ {
+        // the executor arguments an argument specification of `inlined_stencil_stage` reads from memory
+        template <class Arg>
+        struct leaf_args {
+            using type = meta::list<Arg>;
+        };
+
+        template <class Stencil, class... Args>
+        struct leaf_args<lifted_arg<Stencil, Args...>> {
+            using type = meta::dedup<meta::concat<typename leaf_args<Args>::type...>>;
+        };
+
+        template <class Stage>
+        struct stage_args;
+
+        template <class Stencil, int Out, int... Ins>
+        struct stage_args<stencil_stage<Stencil, Out, Ins...>> {
+            using out_t = integral_constant<int, Out>;
+            using ins_t = meta::dedup<meta::list<integral_constant<int, Ins>...>>;
+        };
+
+        template <class Stencil, int Out, class... Args>
+        struct stage_args<inlined_stencil_stage<Stencil, Out, Args...>> {
+            using out_t = integral_constant<int, Out>;
+            using ins_t = meta::dedup<meta::concat<typename leaf_args<Args>::type...>>;
+        };
+
+        // Two stages conflict if one of them writes an argument that the other one reads or writes.
+        // Conservatively, stages of unknown type conflict with everything.
+        template <class, class, class = void>
+        struct conflict : std::true_type {};
+
+        template <class Stage0, class Stage1>
+        struct conflict<Stage0,
+            Stage1,
+            std::void_t<typename stage_args<Stage0>::out_t, typename stage_args<Stage1>::out_t>> {
+            using out0_t = typename stage_args<Stage0>::out_t;
+            using out1_t = typename stage_args<Stage1>::out_t;
+            static constexpr bool value = std::is_same_v<out0_t, out1_t> ||
+                                          meta::st_contains<typename stage_args<Stage1>::ins_t, out0_t>::value ||
+                                          meta::st_contains<typename stage_args<Stage0>::ins_t, out1_t>::value;
+        };
+
+        template <class Stages>
+        struct schedule;
+
+        template <class... Stages>
+        struct schedule<meta::list<Stages...>> {
+            static constexpr std::size_t size = sizeof...(Stages);
+
+            template <class Stage>
+            static constexpr std::array<bool, size> conflicts_of = {conflict<Stage, Stages>::value...};
+
+            // the level of a stage is the length of the longest dependency chain that ends in this stage
+            static constexpr std::array<std::size_t, size> compute_levels() {
+                std::array<std::array<bool, size>, size> conflicts = {conflicts_of<Stages>...};
+                std::array<std::size_t, size> res = {};
+                for (std::size_t i = 0; i < size; ++i)
+                    for (std::size_t j = 0; j < i; ++j)
+                        if (conflicts[j][i] && res[j] + 1 > res[i])
+                            res[i] = res[j] + 1;
+                return res;
+            }
+
+            static constexpr std::array<std::size_t, size> levels = compute_levels();
+
+            static constexpr std::size_t compute_num_levels() {
+                std::size_t res = 0;
+                for (std::size_t i = 0; i < size; ++i)
+                    if (levels[i] + 1 > res)
+                        res = levels[i] + 1;
+                return res;
+            }
+
+            template <class Level>
+            struct is_at_level {
+                template <class I>
+                using apply = std::bool_constant<levels[I::value] == Level::value>;
+            };
+
+            template <class I>
+            using stage_at = meta::at<meta::list<Stages...>, I>;
+
+            template <class Level>
+            using stages_at_level =
+                meta::transform<stage_at, meta::filter<is_at_level<Level>::template apply, meta::make_indices_c<size>>>;
+
+            template <class StageList>
+            using make_stage = meta::if_c<meta::length<StageList>::value == 1,
+                meta::first<StageList>,
+                meta::rename<merged_stencil_stage, StageList>>;
+
+            using type = meta::transform<make_stage,
+                meta::transform<stages_at_level, meta::make_indices_c<compute_num_levels()>>>;
+        };
+    } // namespace stencil_stage_impl_
+
+    namespace stencil_stage_impl_ {
+        template <class Specs, class Transients>
+        struct transient_inliner;
+
+        template <class... Specs, class Transients>
+        struct transient_inliner<meta::list<Specs...>, Transients> {
+            static constexpr std::size_t size = sizeof...(Specs);
+            static constexpr std::array<int, size> outs = {stage_args<Specs>::out_t::value...};
+
+            // the position of the last stage before `pos` that writes `arg`, or `size` if there is none
+            static constexpr std::size_t find_producer(std::size_t pos, int arg) {
+                std::size_t res = size;
+                for (std::size_t i = 0; i < pos; ++i)
+                    if (outs[i] == arg)
+                        res = i;
+                return res;
+            }
+
+            // whether any of the stages in `(first, last)` writes one of the given arguments
+            template <int... Args>
+            static constexpr bool is_written_between(
+                std::size_t first, std::size_t last, meta::list<integral_constant<int, Args>...>) {
+                for (std::size_t i = first + 1; i < last; ++i)
+                    if ((... || (outs[i] == Args)))
+                        return true;
+                return false;
+            }
+
+            template <std::size_t Pos, class Stage>
+            struct lift;
+
+            template <std::size_t Pos, class Arg, bool IsTransient = meta::st_contains<Transients, Arg>::value>
+            struct resolve {
+                using type = Arg;
+            };
+
+            template <std::size_t Pos, class Arg>
+            struct resolve<Pos, Arg, true> {
+                static constexpr std::size_t producer = find_producer(Pos, Arg::value);
+                static_assert(producer != size, "transient argument is read before it is written");
+                using type = typename lift<producer, meta::at_c<meta::list<Specs...>, producer>>::type;
+                static_assert(!is_written_between(producer, Pos, typename leaf_args<type>::type()),
+                    "an input of a transient argument is overwritten before the transient argument is read");
+            };
+
+            template <std::size_t Pos, class Stencil, int Out, int... Ins>
+            struct lift<Pos, stencil_stage<Stencil, Out, Ins...>> {
+                using type = lifted_arg<Stencil, typename resolve<Pos, integral_constant<int, Ins>>::type...>;
+            };
+
+            template <std::size_t Pos, class Stage>
+            struct transform_stage;
+
+            template <std::size_t Pos, class Stencil, int Out, int... Ins>
+            struct transform_stage<Pos, stencil_stage<Stencil, Out, Ins...>> {
+                using inlined_t =
+                    meta::if_c<(... || meta::st_contains<Transients, integral_constant<int, Ins>>::value),
+                        inlined_stencil_stage<Stencil,
+                            Out,
+                            typename resolve<Pos, integral_constant<int, Ins>>::type...>,
+                        stencil_stage<Stencil, Out, Ins...>>;
+                using type = meta::if_<meta::st_contains<Transients, integral_constant<int, Out>>,
+                    meta::list<>,
+                    meta::list<inlined_t>>;
+            };
+
+            template <class Is>
+            struct transform_stages;
+
+            template <std::size_t... Is>
+            struct transform_stages<std::index_sequence<Is...>> {
+                using type = meta::concat<meta::list<>, typename transform_stage<Is, Specs>::type...>;
+            };
+
+            using type = typename transform_stages<std::index_sequence_for<Specs...>>::type;
+        };
+    } // namespace stencil_stage_impl_
+
+    /**
+     *  Eliminates the stages that write transient arguments (given as a list of `integral_constant<int, I>`) by
+     *  inlining them into their consumers: each read of a transient argument is replaced by a `lifted_arg` that
+     *  recomputes the value on the fly. Thus transient arguments are never written to memory.
+     */
+    template <class Stages, class Transients>
+    using inline_transients = typename stencil_stage_impl_::transient_inliner<meta::rename<meta::list, Stages>,
+        meta::rename<meta::list, Transients>>::type;
+
+    /**
+     *  Builds the read/write dependency DAG of the given list of `stencil_stage`s and groups them by level:
+     *  all stages of a level are mutually independent and only depend on stages of previous levels.
+     *  The result is the list of stages to execute in order, where independent stages are fused into a single
+     *  `merged_stencil_stage`, so that they run within the same parallel loop.
+     *
+     *  Note that the dependencies are derived from the argument indices; arguments are assumed not to alias.
+     *  That is why the executors only use this schedule if requested with `merge_independent_stages()`.
+     */
+    template <class Stages>
+    using schedule_stencil_stages = typename stencil_stage_impl_::schedule<meta::rename<meta::list, Stages>>::type;
+
 } // namespace gridtools::fn
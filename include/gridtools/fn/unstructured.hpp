@@ -91,6 +91,27 @@ namespace gridtools::fn {
             return shifted;
         }
 
+        /**
+         * Reduces over the valid neighbors of `it` along connectivity `Conn`. `f(acc, neighbor, local_index)` is
+         * called for each neighbor that exists; the iteration is delegated to `neighbor_table::for_each_neighbor`,
+         * so variable-valence tables (like CSR tables) only loop over their actual neighbors.
+         * `local_index` is the slot of the neighbor in `neighbor_table::neighbors`, per-slot data (like the signs of
+         * the edges of a cell) must be laid out accordingly, including the slots that are `-1`.
+         */
+        template <class Tag, class Ptr, class Strides, class Domain, class Conn, class F, class Init>
+        GT_FUNCTION constexpr Init neighbor_reduction(
+            iterator<Tag, Ptr, Strides, Domain> const &it, Conn, F const &f, Init init) {
+            if (it.m_index == -1)
+                return init;
+            auto const &table = host_device::at_key<Conn>(it.m_domain.m_tables);
+            neighbor_table::for_each_neighbor(table, it.m_index, [&](int local_index, int neighbor) {
+                auto shifted = it;
+                shifted.m_index = neighbor;
+                init = f(std::move(init), shifted, local_index);
+            });
+            return init;
+        }
+
         template <class Tag, class Ptr, class Strides, class Domain, class Dim, class Offset>
         GT_FUNCTION constexpr auto non_horizontal_shift(
             iterator<Tag, Ptr, Strides, Domain> const &it, Dim, Offset offset) {
@@ -174,6 +195,7 @@ namespace gridtools::fn {
     using unstructured_impl_::can_deref;
     using unstructured_impl_::connectivity;
     using unstructured_impl_::deref;
+    using unstructured_impl_::neighbor_reduction;
     using unstructured_impl_::shift;
     using unstructured_impl_::unstructured_domain;
 } // namespace gridtools::fn
@@ -15,9 +15,12 @@
 #include "../common/layout_map.hpp"
 #include "high_level/descriptor_generic_manual.hpp"
 #include "high_level/descriptors.hpp"
+#include "high_level/descriptors_dt.hpp"
 #include "high_level/descriptors_manual_gpu.hpp"
 #include "high_level/field_on_the_fly.hpp"
 #include "low_level/Halo_Exchange_3D.hpp"
+#include "low_level/Halo_Exchange_3D_DT.hpp"
+#include "low_level/Halo_Exchange_3D_SHM.hpp"
 #include "low_level/arch.hpp"
 #include "low_level/proc_grids_3D.hpp"
 
@@ -306,6 +309,164 @@ namespace gridtools {
             grid_type const &comm() const { return hd.comm(); }
         };
 
+        /**
+           Halo exchange pattern with the same interface and packing as \link halo_exchange_dynamic_ut \endlink,
+           where the packed buffers are exchanged through MPI-3 shared memory with the neighbors living on the same
+           node (see \link Halo_Exchange_3D_SHM \endlink). Neighbors on other nodes are served by MPI messages.
+
+           \tparam T_layout_map Layout of the data fields, as in \link halo_exchange_dynamic_ut \endlink
+           \tparam layout2proc_map_abs Map between data dimensions and processor grid dimensions
+           \tparam DataType Value type the elements int the arrays
+        */
+        template <typename T_layout_map, typename layout2proc_map_abs, typename DataType>
+        class halo_exchange_dynamic_ut_shm {
+            using layout_map = reverse_map<T_layout_map>;
+            using layout2proc_map = layout_transform<layout_map, layout2proc_map_abs>;
+
+          public:
+            typedef MPI_3D_process_grid_t<3> grid_type;
+
+            static constexpr int DIMS = 3;
+
+            typedef Halo_Exchange_3D_SHM<grid_type> pattern_type;
+
+          private:
+            hndlr_dynamic_ut<DataType, grid_type, pattern_type, layout2proc_map, cpu> hd;
+
+          public:
+            /**
+               \param[in] c Periodicity specification as in \link boollist_concept \endlink
+               \param[in] comm MPI CART communicator with dimension 3
+            */
+            explicit halo_exchange_dynamic_ut_shm(typename grid_type::period_type const &c, MPI_Comm const &comm)
+                : hd(c.template permute<layout2proc_map_abs>(), comm) {}
+
+            pattern_type const &pattern() const { return hd.pattern(); }
+
+            void setup(int max_fields_n) { hd.setup(max_fields_n); }
+
+            template <int DI>
+            void add_halo(int minus, int plus, int begin, int end, int t_len) {
+                hd.halo.add_halo(layout_map::at(DI), minus, plus, begin, end, t_len);
+            }
+
+            template <int DI>
+            void add_halo(halo_descriptor const &halo) {
+                hd.halo.add_halo(layout_map::at(DI), halo);
+            }
+
+            template <typename... FIELDS>
+            void pack(const FIELDS *..._fields) {
+                hd.pack(_fields...);
+            }
+
+            template <typename... FIELDS>
+            void unpack(FIELDS *..._fields) {
+                hd.unpack(_fields...);
+            }
+
+            void pack(std::vector<DataType *> const &fields) { hd.pack(fields); }
+
+            void unpack(std::vector<DataType *> const &fields) { hd.unpack(fields); }
+
+            void exchange() { hd.exchange(); }
+
+            void post_receives() { hd.post_receives(); }
+
+            void do_sends() { hd.do_sends(); }
+
+            void start_exchange() { hd.start_exchange(); }
+
+            void wait() { hd.wait(); }
+
+            grid_type const &comm() const { return hd.comm(); }
+        };
+
+        /**
+           Halo exchange pattern with the same interface as \link halo_exchange_dynamic_ut \endlink, which transfers
+           the halos with MPI derived datatypes directly from and to the memory of the fields, without packing them
+           into intermediate buffers. Available for host memory only.
+
+           `pack` only registers the fields with the pattern (the datatypes are rebuilt only if the field addresses
+           change) and `unpack` does nothing. Since the data is read during the exchange itself, the fields must
+           not be modified between `pack` and the end of the exchange.
+
+           \tparam T_layout_map Layout of the data fields, as in \link halo_exchange_dynamic_ut \endlink
+           \tparam layout2proc_map_abs Map between data dimensions and processor grid dimensions
+           \tparam DataType Value type the elements int the arrays
+        */
+        template <typename T_layout_map, typename layout2proc_map_abs, typename DataType>
+        class halo_exchange_dynamic_ut_dt {
+            using layout_map = reverse_map<T_layout_map>;
+            using layout2proc_map = layout_transform<layout_map, layout2proc_map_abs>;
+
+          public:
+            typedef MPI_3D_process_grid_t<3> grid_type;
+
+            static constexpr int DIMS = 3;
+
+            typedef Halo_Exchange_3D_DT<grid_type> pattern_type;
+
+          private:
+            hndlr_datatype_ut<DataType, grid_type, layout2proc_map> hd;
+
+          public:
+            /**
+               \param[in] c Periodicity specification as in \link boollist_concept \endlink
+               \param[in] comm MPI CART communicator with dimension 3
+            */
+            explicit halo_exchange_dynamic_ut_dt(typename grid_type::period_type const &c, MPI_Comm const &comm)
+                : hd(c.template permute<layout2proc_map_abs>(), comm) {}
+
+            pattern_type const &pattern() const { return hd.pattern(); }
+
+            /**
+               Creates the datatypes describing the halos of one field. Must be called after all halos are added.
+
+               \param max_fields_n Unused, there are no buffers to allocate
+            */
+            void setup(int /*max_fields_n*/) { hd.setup(); }
+
+            template <int DI>
+            void add_halo(int minus, int plus, int begin, int end, int t_len) {
+                hd.halo.add_halo(layout_map::at(DI), minus, plus, begin, end, t_len);
+            }
+
+            template <int DI>
+            void add_halo(halo_descriptor const &halo) {
+                hd.halo.add_halo(layout_map::at(DI), halo);
+            }
+
+            /**
+               Function to register the fields to be exchanged
+
+               \param[in] _fields data fields to be exchanged
+            */
+            template <typename... FIELDS>
+            void pack(FIELDS *..._fields) {
+                hd.register_fields({_fields...});
+            }
+
+            template <typename... FIELDS>
+            void unpack(FIELDS *...) const {}
+
+            void pack(std::vector<DataType *> const &fields) { hd.register_fields(fields); }
+
+            void unpack(std::vector<DataType *> const &) const {}
+
+            void exchange() { hd.exchange(); }
+
+            void post_receives() { hd.post_receives(); }
+
+            void do_sends() { hd.do_sends(); }
+
+            void start_exchange() { hd.start_exchange(); }
+
+            void wait() { hd.wait(); }
+
+            grid_type const &comm() const { return hd.comm(); }
+        };
+
         /**
            This is the main class for the halo exchange pattern in the case
            in which the data pointers, data types, and shapes are not known
@@ -0,0 +1,196 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <mpi.h>
+
+#include "../common/array.hpp"
+#include "../common/halo_descriptor.hpp"
+#include "../common/layout_map.hpp"
+#include "high_level/descriptor_base.hpp"
+#include "high_level/descriptors.hpp"
+#include "high_level/field_on_the_fly.hpp"
+#include "high_level/helpers_impl.hpp"
+#include "high_level/numerics.hpp"
+#include "low_level/Halo_Exchange_3D.hpp"
+#include "low_level/proc_grids_3D.hpp"
+#include "low_level/translate.hpp"
+
+/**
+@file
+@brief Halo exchange of fields with different element types and halos in a single message per neighbor.
+
+The fields are described by data stores together with their halo descriptors (see `gcl::halo_field`). For every
+neighbor the halo regions of all the fields are packed one after the other into one buffer, each field starting at
+an offset aligned for any element type, so a single exchange sends one message per neighbor regardless of the number
+and the types of the fields. The buffers grow on demand and are reused by the following exchanges.
+*/
+
+namespace gridtools {
+    namespace gcl {
+        namespace heterogeneous_halo_exchange_impl_ {
+            template <class>
+            struct traits {
+                static const int I = 3;
+                typedef empty_field_no_dt base_field;
+            };
+
+            constexpr std::size_t align_up(std::size_t n) {
+                return (n + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+            }
+
+            template <class Field>
+            std::size_t send_bytes(Field const &field, array<int, 3> const &eta) {
+                return align_up(field.send_buffer_size(eta) * sizeof(typename Field::value_type));
+            }
+
+            template <class Field>
+            std::size_t recv_bytes(Field const &field, array<int, 3> const &eta) {
+                return align_up(field.recv_buffer_size(eta) * sizeof(typename Field::value_type));
+            }
+        } // namespace heterogeneous_halo_exchange_impl_
+
+        /**
+           Field description accepted by heterogeneous_halo_exchange.
+         */
+        template <class DataType, class Layout>
+        using heterogeneous_field = field_on_the_fly<DataType, Layout, heterogeneous_halo_exchange_impl_::traits>;
+
+        /**
+           Describes a data store with its halos for heterogeneous_halo_exchange.
+
+           \param data_store The data store, its target pointer has to be accessible from the host
+           \param halos Halo descriptors in the order of the dimensions of the data store
+         */
+        template <class DataStore>
+        auto halo_field(DataStore const &data_store, array<halo_descriptor, 3> const &halos) {
+            using storage_t = typename DataStore::element_type;
+            return heterogeneous_field<typename storage_t::data_t, typename storage_t::layout_t>(
+                data_store->get_target_ptr(), halos);
+        }
+
+        /**
+           Halo exchange pattern for fields with arbitrary element types and halos, that are all sent to a neighbor
+           in a single message. The fields must share the same layout.
+
+           \tparam layout2proc_map Layout_map \link gridtools::layout_map \endlink specifying which dimension in the
+           data corresponds to the which dimension in the processor grid
+         */
+        template <typename layout2proc_map = layout_map<0, 1, 2>>
+        class heterogeneous_halo_exchange : public descriptor_base<Halo_Exchange_3D<MPI_3D_process_grid_t<3>>> {
+            typedef descriptor_base<Halo_Exchange_3D<MPI_3D_process_grid_t<3>>> base_type;
+            typedef translate_t<3> translate;
+
+            array<std::vector<char>, static_pow3(3)> m_send_buffers;
+            array<std::vector<char>, static_pow3(3)> m_recv_buffers;
+
+            template <class Field, class F>
+            void for_each_neighbor(F &&f) const {
+                using proc_layout = layout_transform<typename Field::inner_layoutmap, layout2proc_map>;
+                for (int ii = -1; ii <= 1; ++ii)
+                    for (int jj = -1; jj <= 1; ++jj)
+                        for (int kk = -1; kk <= 1; ++kk) {
+                            if (ii == 0 && jj == 0 && kk == 0)
+                                continue;
+                            const int ii_P = nth<proc_layout, 0>(ii, jj, kk);
+                            const int jj_P = nth<proc_layout, 1>(ii, jj, kk);
+                            const int kk_P = nth<proc_layout, 2>(ii, jj, kk);
+                            if (this->pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)
+                                f(array<int, 3>{ii, jj, kk}, translate()(ii, jj, kk), ii_P, jj_P, kk_P);
+                        }
+            }
+
+          public:
+            typedef typename base_type::grid_type grid_type;
+            typedef typename base_type::pattern_type pattern_type;
+
+            /**
+               \param[in] c Periodicity specification as in \link boollist_concept \endlink, in the order of the data
+               \param[in] comm MPI CART communicator with three dimensions
+            */
+            explicit heterogeneous_halo_exchange(typename grid_type::period_type const &c, MPI_Comm comm)
+                : base_type(grid_type(c.template permute<layout2proc_map>(), comm)) {}
+
+            grid_type const &comm() const { return this->pattern().proc_grid(); }
+
+            /**
+               Packs the halos of the fields to be sent and registers the buffers with the pattern.
+
+               \param[in] fields Fields created with gcl::halo_field
+            */
+            template <typename First, typename... Fields>
+            void pack(First const &first, Fields const &...fields) {
+                using namespace heterogeneous_halo_exchange_impl_;
+                static_assert(std::conjunction_v<
+                                  std::is_same<typename First::inner_layoutmap, typename Fields::inner_layoutmap>...>,
+                    "All fields exchanged together must share the same layout");
+                for_each_neighbor<First>([&](array<int, 3> const &eta, int idx, int ii_P, int jj_P, int kk_P) {
+                    std::size_t send_size = (send_bytes(first, eta) + ... + send_bytes(fields, eta));
+                    std::size_t recv_size = (recv_bytes(first, eta) + ... + recv_bytes(fields, eta));
+                    if (m_send_buffers[idx].size() < send_size)
+                        m_send_buffers[idx].resize(send_size);
+                    if (m_recv_buffers[idx].size() < recv_size)
+                        m_recv_buffers[idx].resize(recv_size);
+
+                    char *begin = m_send_buffers[idx].data();
+                    auto pack_field = [&](auto const &field) {
+                        char *it = begin;
+                        field.pack(eta, field.ptr, it);
+                        begin += send_bytes(field, eta);
+                    };
+                    pack_field(first);
+                    (pack_field(fields), ...);
+
+                    this->m_haloexch.register_send_to_buffer(m_send_buffers[idx].data(), send_size, ii_P, jj_P, kk_P);
+                    this->m_haloexch.register_receive_from_buffer(
+                        m_recv_buffers[idx].data(), recv_size, ii_P, jj_P, kk_P);
+                });
+            }
+
+            /**
+               Unpacks the received halos into the fields, which must be the same as passed to pack.
+
+               \param[in] fields Fields created with gcl::halo_field
+            */
+            template <typename First, typename... Fields>
+            void unpack(First const &first, Fields const &...fields) {
+                using namespace heterogeneous_halo_exchange_impl_;
+                for_each_neighbor<First>([&](array<int, 3> const &eta, int idx, int, int, int) {
+                    char *begin = m_recv_buffers[idx].data();
+                    auto unpack_field = [&](auto const &field) {
+                        char *it = begin;
+                        field.unpack(eta, field.ptr, it);
+                        begin += recv_bytes(field, eta);
+                    };
+                    unpack_field(first);
+                    (unpack_field(fields), ...);
+                });
+            }
+
+            using base_type::exchange;
+
+            /**
+               Exchanges the halos of all the fields, one message is sent to every neighbor.
+
+               \param[in] fields Fields created with gcl::halo_field
+            */
+            template <typename... Fields>
+            void exchange(Fields const &...fields) {
+                pack(fields...);
+                base_type::exchange();
+                unpack(fields...);
+            }
+        };
+    } // namespace gcl
+} // namespace gridtools
@@ -0,0 +1,162 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <mpi.h>
+
+#include "../../common/array.hpp"
+#include "../low_level/Halo_Exchange_3D_DT.hpp"
+#include "../low_level/translate.hpp"
+#include "descriptor_base.hpp"
+#include "empty_field_base.hpp"
+#include "helpers_impl.hpp"
+
+namespace gridtools {
+    namespace gcl {
+        /**
+            Counterpart of `hndlr_dynamic_ut` which does not pack. For every neighbor one subarray datatype
+            describing the halo region of one field is created in `setup` and cached. When fields are registered,
+            these are combined into one datatype per neighbor holding the absolute addresses of all the fields, so
+            that a single message per neighbor is sent directly from (and received directly into) field memory.
+            The combined datatypes are only rebuilt if the field addresses change.
+
+            All fields must have the same value type, layout and halos.
+
+            \tparam DataType Value type of the fields
+            \tparam GridType Processor grid type
+            \tparam proc_layout Map between data dimensions (in increasing stride order) and processor grid
+        */
+        template <typename DataType, typename GridType, typename proc_layout>
+        class hndlr_datatype_ut : public descriptor_base<Halo_Exchange_3D_DT<GridType>> {
+            static const int DIMS = GridType::ndims;
+            typedef translate_t<DIMS> translate;
+            typedef array<MPI_Datatype, static_pow3(DIMS)> types_t;
+
+            types_t m_send_subarrays;
+            types_t m_recv_subarrays;
+            types_t m_send_types;
+            types_t m_recv_types;
+            std::vector<DataType *> m_fields;
+
+          public:
+            empty_field_base<DataType> halo;
+
+            typedef descriptor_base<Halo_Exchange_3D_DT<GridType>> base_type;
+            typedef typename base_type::pattern_type pattern_type;
+            typedef typename pattern_type::grid_type grid_type;
+
+          private:
+            static void null_types(types_t &types) {
+                for (auto &type : types)
+                    type = MPI_DATATYPE_NULL;
+            }
+
+            static void free_types(types_t &types) {
+                for (auto &type : types)
+                    if (type != MPI_DATATYPE_NULL)
+                        MPI_Type_free(&type);
+            }
+
+            template <class F>
+            void for_each_neighbor(F &&f) const {
+                for (int ii = -1; ii <= 1; ++ii)
+                    for (int jj = -1; jj <= 1; ++jj)
+                        for (int kk = -1; kk <= 1; ++kk)
+                            if (ii != 0 || jj != 0 || kk != 0)
+                                f(ii, jj, kk);
+            }
+
+            static MPI_Datatype combine(MPI_Datatype subarray, std::vector<MPI_Aint> const &displacements) {
+                if (subarray == MPI_DATATYPE_NULL)
+                    return MPI_DATATYPE_NULL;
+                MPI_Datatype res;
+                MPI_Type_create_hindexed_block(displacements.size(), 1, displacements.data(), subarray, &res);
+                MPI_Type_commit(&res);
+                return res;
+            }
+
+            hndlr_datatype_ut(hndlr_datatype_ut const &) = delete;
+            hndlr_datatype_ut(hndlr_datatype_ut &&) = delete;
+
+          public:
+            /**
+               Constructor
+
+               \param[in] c The object of the class used to specify periodicity in each dimension
+               \param[in] comm MPI communicator (typically MPI_Comm_world)
+            */
+            explicit hndlr_datatype_ut(typename grid_type::period_type const &c, MPI_Comm const &comm)
+                : base_type(c, comm) {
+                null_types(m_send_subarrays);
+                null_types(m_recv_subarrays);
+                null_types(m_send_types);
+                null_types(m_recv_types);
+            }
+
+            ~hndlr_datatype_ut() {
+                free_types(m_send_subarrays);
+                free_types(m_recv_subarrays);
+                free_types(m_send_types);
+                free_types(m_recv_types);
+            }
+
+            /**
+               Creates the subarray datatypes of one field for all the neighbors. Must be called after the halos
+               are set.
+            */
+            void setup() {
+                free_types(m_send_subarrays);
+                free_types(m_recv_subarrays);
+                for_each_neighbor([&](int ii, int jj, int kk) {
+                    array<int, DIMS> eta = {ii, jj, kk};
+                    auto send = _impl::make_datatype_outin<DataType>::inside(halo.halos, eta);
+                    auto recv = _impl::make_datatype_outin<DataType>::outside(halo.halos, eta);
+                    m_send_subarrays[translate()(ii, jj, kk)] = send.second ? send.first : MPI_DATATYPE_NULL;
+                    m_recv_subarrays[translate()(ii, jj, kk)] = recv.second ? recv.first : MPI_DATATYPE_NULL;
+                });
+                m_fields.clear();
+            }
+
+            /**
+               Registers the fields to be exchanged with the pattern.
+
+               \param[in] fields pointers to the fields
+            */
+            void register_fields(std::vector<DataType *> const &fields) {
+                if (fields == m_fields)
+                    return;
+                m_fields = fields;
+                free_types(m_send_types);
+                free_types(m_recv_types);
+                std::vector<MPI_Aint> displacements(fields.size());
+                for (std::size_t i = 0; i != fields.size(); ++i)
+                    MPI_Get_address(fields[i], &displacements[i]);
+                for_each_neighbor([&](int ii, int jj, int kk) {
+                    int idx = translate()(ii, jj, kk);
+                    if (!fields.empty()) {
+                        m_send_types[idx] = combine(m_send_subarrays[idx], displacements);
+                        m_recv_types[idx] = combine(m_recv_subarrays[idx], displacements);
+                    }
+                    typedef proc_layout map_type;
+                    const int ii_P = nth<map_type, 0>(ii, jj, kk);
+                    const int jj_P = nth<map_type, 1>(ii, jj, kk);
+                    const int kk_P = nth<map_type, 2>(ii, jj, kk);
+                    this->m_haloexch.register_send_to(MPI_BOTTOM, m_send_types[idx], ii_P, jj_P, kk_P);
+                    this->m_haloexch.register_receive_from(MPI_BOTTOM, m_recv_types[idx], ii_P, jj_P, kk_P);
+                });
+            }
+
+            pattern_type const &pattern() const { return base_type::pattern(); }
+        };
+    } // namespace gcl
+} // namespace gridtools
@@ -0,0 +1,164 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cassert>
+
+#include <mpi.h>
+
+#include "../../common/array.hpp"
+#include "translate.hpp"
+
+namespace gridtools {
+    namespace gcl {
+        /** \class Halo_Exchange_3D_DT
+         * Variant of \link Halo_Exchange_3D \endlink where the messages are described by MPI derived datatypes
+         * instead of contiguous byte buffers.
+         *
+         * For every neighbor a (pointer, datatype) pair is registered for sending and for receiving. The pointer
+         * is typically `MPI_BOTTOM` and the datatype encodes the absolute addresses of the halo regions in field
+         * memory, so the data is transferred in place without packing into intermediate buffers. The pattern
+         * only references the datatypes, their ownership stays with the caller.
+         *
+         * The neighbors, the tags and the processor grid semantics are the same as in \link Halo_Exchange_3D
+         * \endlink.
+         *
+         * \tparam PROC_GRID Processor Grid type. An object of this type will be passed to constructor.
+         */
+        template <typename PROC_GRID>
+        class Halo_Exchange_3D_DT {
+            typedef translate_t<3> translate;
+
+            struct message {
+                void *ptr = nullptr;
+                MPI_Datatype type = MPI_DATATYPE_NULL;
+            };
+
+            array<message, 27> m_send;
+            array<message, 27> m_recv;
+            array<MPI_Request, 27> m_send_requests;
+            array<MPI_Request, 27> m_recv_requests;
+            array<bool, 27> m_send_pending = {};
+            array<bool, 27> m_recv_pending = {};
+
+            const PROC_GRID m_proc_grid;
+
+            static int tag(int I, int J, int K) { return (K + 1) * 9 + (I + 1) * 3 + J + 1; }
+
+            template <class F>
+            void for_each_neighbor(F &&f) {
+                for (int i = -1; i <= 1; ++i)
+                    for (int j = -1; j <= 1; ++j)
+                        for (int k = -1; k <= 1; ++k)
+                            if ((i != 0 || j != 0 || k != 0) && m_proc_grid.proc(i, j, k) != -1)
+                                f(i, j, k, translate()(i, j, k));
+            }
+
+          public:
+            /** Type of the processor grid used by the pattern
+             */
+            typedef PROC_GRID grid_type;
+
+            /** Type of the translation map to map processors to messages.
+             */
+            typedef translate translate_type;
+
+            /** Constructor that takes the process grid. Must be executed by all the processes in the grid.
+             */
+            explicit Halo_Exchange_3D_DT(PROC_GRID _pg) : m_proc_grid(_pg) {}
+
+            /** Function to retrieve the grid from the pattern.
+             */
+            PROC_GRID const &proc_grid() const { return m_proc_grid; }
+
+            /** Register the data to be sent to the neighbor with relative coordinates I, J and K.
+
+                \param[in] p Base address the datatype is relative to (`MPI_BOTTOM` for absolute addresses)
+                \param[in] type Committed datatype describing the data; `MPI_DATATYPE_NULL` disables the message
+            */
+            void register_send_to(void *p, MPI_Datatype type, int I, int J, int K) {
+                assert((I >= -1 && I <= 1));
+                assert((J >= -1 && J <= 1));
+                assert((K >= -1 && K <= 1));
+                m_send[translate()(I, J, K)] = {p, type};
+            }
+
+            /** Register where the data received from the neighbor with relative coordinates I, J and K is stored.
+
+                \param[in] p Base address the datatype is relative to (`MPI_BOTTOM` for absolute addresses)
+                \param[in] type Committed datatype describing the data; `MPI_DATATYPE_NULL` disables the message
+            */
+            void register_receive_from(void *p, MPI_Datatype type, int I, int J, int K) {
+                assert((I >= -1 && I <= 1));
+                assert((J >= -1 && J <= 1));
+                assert((K >= -1 && K <= 1));
+                m_recv[translate()(I, J, K)] = {p, type};
+            }
+
+            /** When called this function executes the communication pattern. When the function returns the
+                received data can be safely accessed.
+             */
+            void exchange() {
+                start_exchange();
+                wait();
+            }
+
+            void post_receives() {
+                for_each_neighbor([&](int i, int j, int k, int idx) {
+                    if (m_recv[idx].type == MPI_DATATYPE_NULL)
+                        return;
+                    MPI_Irecv(m_recv[idx].ptr,
+                        1,
+                        m_recv[idx].type,
+                        m_proc_grid.proc(i, j, k),
+                        tag(-i, -j, -k),
+                        m_proc_grid.communicator(),
+                        &m_recv_requests[idx]);
+                    m_recv_pending[idx] = true;
+                });
+            }
+
+            void do_sends() {
+                for_each_neighbor([&](int i, int j, int k, int idx) {
+                    if (m_send[idx].type == MPI_DATATYPE_NULL)
+                        return;
+                    MPI_Isend(m_send[idx].ptr,
+                        1,
+                        m_send[idx].type,
+                        m_proc_grid.proc(i, j, k),
+                        tag(i, j, k),
+                        m_proc_grid.communicator(),
+                        &m_send_requests[idx]);
+                    m_send_pending[idx] = true;
+                });
+            }
+
+            /** Initiates the data exchange. The registered data should not be accessed until wait() returns.
+             */
+            void start_exchange() {
+                post_receives();
+                do_sends();
+            }
+
+            void wait() {
+                for (int idx = 0; idx != 27; ++idx) {
+                    if (m_send_pending[idx]) {
+                        MPI_Wait(&m_send_requests[idx], MPI_STATUS_IGNORE);
+                        m_send_pending[idx] = false;
+                    }
+                    if (m_recv_pending[idx]) {
+                        MPI_Wait(&m_recv_requests[idx], MPI_STATUS_IGNORE);
+                        m_recv_pending[idx] = false;
+                    }
+                }
+            }
+        };
+    } // namespace gcl
+} // namespace gridtools
@@ -0,0 +1,332 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <mpi.h>
+
+#include "../../common/array.hpp"
+#include "translate.hpp"
+
+namespace gridtools {
+    namespace gcl {
+        /** \class Halo_Exchange_3D_SHM
+         * Drop-in replacement of \link Halo_Exchange_3D \endlink (same buffer registration interface) that
+         * exchanges the buffers with neighbors living on the same node through MPI-3 shared memory.
+         *
+         * Every process allocates a shared window (`MPI_Win_allocate_shared` on the communicator obtained with
+         * `MPI_Comm_split_type(MPI_COMM_TYPE_SHARED)`) holding one slot per neighbor, sized like the registered
+         * receive buffer. A sender copies its send buffer directly into the slot of the receiving process and
+         * raises the flag of the slot; the receiver waits for the flag, copies the slot into its receive buffer
+         * and clears the flag again, which allows the next message to be written. Neighbors on other nodes are
+         * served with isend/irecv as in \link Halo_Exchange_3D \endlink.
+         *
+         * The window is allocated by the first exchange after the receive buffers were registered, so the
+         * first exchange is collective over the node. Receive buffers can not grow after that; sending more bytes
+         * to a neighbor on the same node than its registered receive buffer holds throws `std::runtime_error`
+         * before anything is sent, after cancelling the posted receives. The neighbors on other nodes are not
+         * notified and would wait for the messages of this process.
+         *
+         * \tparam PROC_GRID Processor Grid type. An object of this type will be passed to constructor.
+         */
+        template <typename PROC_GRID>
+        class Halo_Exchange_3D_SHM {
+            typedef translate_t<3> translate;
+
+            struct buffer {
+                char *ptr = nullptr;
+                int size = 0;
+                int capacity = 0;
+            };
+
+            struct slot {
+                std::atomic<int> full;
+                int size;
+                int capacity;
+                std::size_t offset;
+            };
+
+            struct neighbor {
+                int rank = -1;      // rank in the process grid, -1 if there is no neighbor
+                int node_rank = -1; // rank in the node communicator, -1 if on another node
+                char *window = nullptr;
+            };
+
+            static constexpr std::size_t alignment = 64;
+
+            array<buffer, 27> m_send;
+            array<buffer, 27> m_recv;
+            array<neighbor, 27> m_neighbors;
+            array<MPI_Request, 27> m_send_requests;
+            array<MPI_Request, 27> m_recv_requests;
+            array<bool, 27> m_send_pending = {};
+            array<bool, 27> m_recv_pending = {};
+
+            const PROC_GRID m_proc_grid;
+            MPI_Comm m_node_comm;
+            MPI_Win m_window = MPI_WIN_NULL;
+            char *m_window_base = nullptr;
+
+            static int tag(int I, int J, int K) { return (K + 1) * 9 + (I + 1) * 3 + J + 1; }
+
+            static slot *slots(char *window) { return reinterpret_cast<slot *>(window); }
+
+            static std::size_t round_up(std::size_t n) { return (n + alignment - 1) / alignment * alignment; }
+
+            template <class F>
+            void for_each_neighbor(F &&f) {
+                for (int i = -1; i <= 1; ++i)
+                    for (int j = -1; j <= 1; ++j)
+                        for (int k = -1; k <= 1; ++k) {
+                            int idx = translate()(i, j, k);
+                            if ((i != 0 || j != 0 || k != 0) && m_neighbors[idx].rank != -1)
+                                f(i, j, k, idx);
+                        }
+            }
+
+            // keeps the MPI progress engine going while waiting, since remote messages may be in flight
+            void spin_until(std::atomic<int> const &flag, int value) const {
+                while (flag.load(std::memory_order_acquire) != value) {
+                    int dummy;
+                    MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, m_proc_grid.communicator(), &dummy, MPI_STATUS_IGNORE);
+                    std::this_thread::yield();
+                }
+            }
+
+            void allocate_window() {
+                std::size_t size = round_up(27 * sizeof(slot));
+                array<std::size_t, 27> offsets;
+                for (int idx = 0; idx != 27; ++idx) {
+                    offsets[idx] = size;
+                    size += round_up(m_recv[idx].capacity);
+                }
+                MPI_Win_allocate_shared(size, 1, MPI_INFO_NULL, m_node_comm, &m_window_base, &m_window);
+                for (int idx = 0; idx != 27; ++idx) {
+                    slot *s = new (slots(m_window_base) + idx) slot;
+                    s->full.store(0, std::memory_order_relaxed);
+                    s->size = 0;
+                    s->capacity = m_recv[idx].capacity;
+                    s->offset = offsets[idx];
+                }
+                MPI_Win_lock_all(MPI_MODE_NOCHECK, m_window);
+                MPI_Barrier(m_node_comm);
+                for_each_neighbor([&](int, int, int, int idx) {
+                    if (m_neighbors[idx].node_rank == -1)
+                        return;
+                    MPI_Aint window_size;
+                    int disp_unit;
+                    MPI_Win_shared_query(
+                        m_window, m_neighbors[idx].node_rank, &window_size, &disp_unit, &m_neighbors[idx].window);
+                });
+            }
+
+          public:
+            /** Type of the processor grid used by the pattern
+             */
+            typedef PROC_GRID grid_type;
+
+            /** Type of the translation map to map processors to buffers.
+             */
+            typedef translate translate_type;
+
+            /** Constructor that takes the process grid. Must be executed by all the processes in the grid.
+             */
+            explicit Halo_Exchange_3D_SHM(PROC_GRID _pg) : m_proc_grid(_pg) {
+                MPI_Comm comm = m_proc_grid.communicator();
+                MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &m_node_comm);
+                MPI_Group group, node_group;
+                MPI_Comm_group(comm, &group);
+                MPI_Comm_group(m_node_comm, &node_group);
+                for (int i = -1; i <= 1; ++i)
+                    for (int j = -1; j <= 1; ++j)
+                        for (int k = -1; k <= 1; ++k) {
+                            neighbor &n = m_neighbors[translate()(i, j, k)];
+                            n.rank = m_proc_grid.proc(i, j, k);
+                            if (n.rank == -1)
+                                continue;
+                            MPI_Group_translate_ranks(group, 1, &n.rank, node_group, &n.node_rank);
+                            if (n.node_rank == MPI_UNDEFINED)
+                                n.node_rank = -1;
+                        }
+                MPI_Group_free(&group);
+                MPI_Group_free(&node_group);
+            }
+
+            Halo_Exchange_3D_SHM(Halo_Exchange_3D_SHM const &) = delete;
+            Halo_Exchange_3D_SHM &operator=(Halo_Exchange_3D_SHM const &) = delete;
+
+            ~Halo_Exchange_3D_SHM() {
+                if (m_window != MPI_WIN_NULL) {
+                    MPI_Win_unlock_all(m_window);
+                    MPI_Win_free(&m_window);
+                }
+                MPI_Comm_free(&m_node_comm);
+            }
+
+            /** Function to retrieve the grid from the pattern, from which user can query location information.
+             */
+            PROC_GRID const &proc_grid() const { return m_proc_grid; }
+
+            /** Returns true if the neighbor with relative coordinates I, J and K is served through shared memory.
+             */
+            bool is_shared(int I, int J, int K) const { return m_neighbors[translate()(I, J, K)].node_rank != -1; }
+
+            /** Function to register send buffers with the communication pattern, see \link Halo_Exchange_3D
+             * \endlink.
+             */
+            void register_send_to_buffer(void *p, int s, int I, int J, int K) {
+                assert((I >= -1 && I <= 1));
+                assert((J >= -1 && J <= 1));
+                assert((K >= -1 && K <= 1));
+                m_send[translate()(I, J, K)] = {reinterpret_cast<char *>(p), s, s};
+            }
+
+            /** Function to register receive buffers with the communication pattern, see \link Halo_Exchange_3D
+             * \endlink.
+             */
+            void register_receive_from_buffer(void *p, int s, int I, int J, int K) {
+                assert((I >= -1 && I <= 1));
+                assert((J >= -1 && J <= 1));
+                assert((K >= -1 && K <= 1));
+                assert(m_window == MPI_WIN_NULL || s <= m_recv[translate()(I, J, K)].capacity);
+                buffer &b = m_recv[translate()(I, J, K)];
+                b.ptr = reinterpret_cast<char *>(p);
+                b.size = s;
+                if (m_window == MPI_WIN_NULL)
+                    b.capacity = s;
+            }
+
+            void set_send_to_size(int s, int I, int J, int K) {
+                assert(s <= m_send[translate()(I, J, K)].capacity);
+                m_send[translate()(I, J, K)].size = s;
+            }
+
+            void set_receive_from_size(int s, int I, int J, int K) {
+                assert(s <= m_recv[translate()(I, J, K)].capacity);
+                m_recv[translate()(I, J, K)].size = s;
+            }
+
+            int send_size(int I, int J, int K) const { return m_send[translate()(I, J, K)].size; }
+
+            int recv_size(int I, int J, int K) const { return m_recv[translate()(I, J, K)].size; }
+
+            /** When called this function executes the communication pattern. When the function returns the data
+                in receive buffers can be safely accessed.
+             */
+            void exchange() {
+                start_exchange();
+                wait();
+            }
+
+            void post_receives() {
+                if (m_window == MPI_WIN_NULL)
+                    allocate_window();
+                for_each_neighbor([&](int i, int j, int k, int idx) {
+                    if (m_neighbors[idx].node_rank != -1 || !m_recv[idx].size)
+                        return;
+                    MPI_Irecv(m_recv[idx].ptr,
+                        m_recv[idx].size,
+                        MPI_CHAR,
+                        m_neighbors[idx].rank,
+                        tag(-i, -j, -k),
+                        m_proc_grid.communicator(),
+                        &m_recv_requests[idx]);
+                    m_recv_pending[idx] = true;
+                });
+            }
+
+            // cancels the receives that were posted by post_receives, they are completed before returning
+            void cancel_receives() {
+                for_each_neighbor([&](int, int, int, int idx) {
+                    if (!m_recv_pending[idx])
+                        return;
+                    MPI_Cancel(&m_recv_requests[idx]);
+                    MPI_Wait(&m_recv_requests[idx], MPI_STATUS_IGNORE);
+                    m_recv_pending[idx] = false;
+                });
+            }
+
+            void do_sends() {
+                // the slots were sized by the receivers when they allocated their windows; all the sizes are checked
+                // before anything is sent, so nothing is left in flight if one of them does not fit
+                for_each_neighbor([&](int i, int j, int k, int idx) {
+                    if (m_neighbors[idx].node_rank == -1)
+                        return;
+                    int capacity = slots(m_neighbors[idx].window)[translate()(-i, -j, -k)].capacity;
+                    if (m_send[idx].size <= capacity)
+                        return;
+                    cancel_receives();
+                    throw std::runtime_error("Halo_Exchange_3D_SHM: send buffer of " +
+                                             std::to_string(m_send[idx].size) + " bytes exceeds the " +
+                                             std::to_string(capacity) + " bytes receive slot of rank " +
+                                             std::to_string(m_neighbors[idx].rank));
+                });
+                for_each_neighbor([&](int i, int j, int k, int idx) {
+                    if (!m_send[idx].size)
+                        return;
+                    if (m_neighbors[idx].node_rank == -1) {
+                        MPI_Isend(m_send[idx].ptr,
+                            m_send[idx].size,
+                            MPI_CHAR,
+                            m_neighbors[idx].rank,
+                            tag(i, j, k),
+                            m_proc_grid.communicator(),
+                            &m_send_requests[idx]);
+                        m_send_pending[idx] = true;
+                        return;
+                    }
+                    // the receiver sees this process at the opposite relative position
+                    char *window = m_neighbors[idx].window;
+                    slot &s = slots(window)[translate()(-i, -j, -k)];
+                    spin_until(s.full, 0);
+                    std::memcpy(window + s.offset, m_send[idx].ptr, m_send[idx].size);
+                    s.size = m_send[idx].size;
+                    s.full.store(1, std::memory_order_release);
+                });
+            }
+
+            /** When called this function initiate the data exchange. Buffers should not be considered safe to
+                access until the wait() function returns.
+             */
+            void start_exchange() {
+                post_receives();
+                do_sends();
+            }
+
+            void wait() {
+                for_each_neighbor([&](int, int, int, int idx) {
+                    if (m_send_pending[idx]) {
+                        MPI_Wait(&m_send_requests[idx], MPI_STATUS_IGNORE);
+                        m_send_pending[idx] = false;
+                    }
+                    if (m_recv_pending[idx]) {
+                        MPI_Wait(&m_recv_requests[idx], MPI_STATUS_IGNORE);
+                        m_recv_pending[idx] = false;
+                    }
+                    if (m_neighbors[idx].node_rank == -1 || !m_recv[idx].size)
+                        return;
+                    slot &s = slots(m_window_base)[idx];
+                    spin_until(s.full, 1);
+                    assert(s.size == m_recv[idx].size);
+                    std::memcpy(m_recv[idx].ptr, m_window_base + s.offset, s.size);
+                    s.full.store(0, std::memory_order_release);
+                });
+            }
+        };
+    } // namespace gcl
+} // namespace gridtools
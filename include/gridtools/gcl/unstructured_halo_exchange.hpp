@@ -0,0 +1,324 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "../common/defs.hpp"
+#include "../common/hymap.hpp"
+#include "../common/integral_constant.hpp"
+#include "../sid/concept.hpp"
+
+/**
+@file
+@brief Halo exchange for unstructured meshes partitioned among MPI ranks.
+
+Every rank stores its elements (vertices, edges, ...) with local indices `0..n-1`. The first `num_owned` local
+elements are owned by the rank, the remaining ones are ghosts, i.e. copies of elements owned by other ranks.
+The pattern is built from the global index of every local element. The owners of the ghosts are found with a
+distributed directory (global index `g` is registered at rank `g % size`), so no rank needs to know the whole mesh.
+The result are per peer lists of local indices to send and to receive.
+
+The fields are SIDs with a horizontal dimension (the local index) and optionally a vertical dimension, which then
+must be bounded from above. All fields passed to one `exchange` are sent in a single message per peer; gathering
+and scattering is threaded.
+*/
+
+namespace gridtools {
+    namespace gcl {
+        namespace unstructured_halo_exchange_impl_ {
+            // all-to-all exchange of variable length integer lists, `send[r]` is sent to rank `r`
+            inline std::vector<std::vector<int>> all_to_all(MPI_Comm comm, std::vector<std::vector<int>> const &send) {
+                int size;
+                MPI_Comm_size(comm, &size);
+                std::vector<int> send_counts(size), recv_counts(size), send_displs(size), recv_displs(size);
+                for (int r = 0; r != size; ++r)
+                    send_counts[r] = send[r].size();
+                MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, comm);
+                std::exclusive_scan(send_counts.begin(), send_counts.end(), send_displs.begin(), 0);
+                std::exclusive_scan(recv_counts.begin(), recv_counts.end(), recv_displs.begin(), 0);
+                std::vector<int> send_data, recv_data(recv_displs.back() + recv_counts.back());
+                send_data.reserve(send_displs.back() + send_counts.back());
+                for (auto const &s : send)
+                    send_data.insert(send_data.end(), s.begin(), s.end());
+                MPI_Alltoallv(send_data.data(),
+                    send_counts.data(),
+                    send_displs.data(),
+                    MPI_INT,
+                    recv_data.data(),
+                    recv_counts.data(),
+                    recv_displs.data(),
+                    MPI_INT,
+                    comm);
+                std::vector<std::vector<int>> res(size);
+                for (int r = 0; r != size; ++r)
+                    res[r].assign(recv_data.begin() + recv_displs[r],
+                        recv_data.begin() + recv_displs[r] + recv_counts[r]);
+                return res;
+            }
+
+            // throws on all ranks of `comm` if `failed` is set on any of them
+            inline void check_on_all_ranks(MPI_Comm comm, bool failed, std::string const &what) {
+                int any_failed = failed;
+                MPI_Allreduce(MPI_IN_PLACE, &any_failed, 1, MPI_INT, MPI_LOR, comm);
+                if (failed)
+                    throw std::runtime_error("unstructured_halo_exchange: " + what);
+                if (any_failed)
+                    throw std::runtime_error("unstructured_halo_exchange: construction failed on another rank");
+            }
+
+            template <class VerticalDim, class Sid>
+            int num_levels(Sid &sid) {
+                if constexpr (has_key<sid::strides_type<Sid>, VerticalDim>::value) {
+                    static_assert(has_key<sid::upper_bounds_type<Sid>, VerticalDim>::value,
+                        "fields with a vertical dimension must have an upper bound in that dimension");
+                    return at_key<VerticalDim>(sid::get_upper_bounds(sid));
+                } else {
+                    return 1;
+                }
+            }
+
+            template <class HorizontalDim, class VerticalDim, class Sid>
+            struct field {
+                using ptr_t = sid::ptr_type<Sid>;
+                using element_t = std::remove_const_t<sid::element_type<Sid>>;
+                static_assert(std::is_trivially_copyable_v<element_t>, GT_INTERNAL_ERROR);
+
+                ptr_t origin;
+                sid::strides_type<Sid> strides;
+                int levels;
+
+                field(Sid &sid)
+                    : origin(sid::get_origin(sid)()), strides(sid::get_strides(sid)),
+                      levels(num_levels<VerticalDim>(sid)) {}
+
+                std::size_t bytes() const { return sizeof(element_t) * levels; }
+
+                ptr_t ptr(int index) const {
+                    ptr_t res = origin;
+                    sid::shift(res, sid::get_stride<HorizontalDim>(strides), index);
+                    return res;
+                }
+
+                void gather(int index, char *dst) const {
+                    ptr_t p = ptr(index);
+                    auto &&stride = sid::get_stride<VerticalDim>(strides);
+                    for (int k = 0; k != levels; ++k) {
+                        element_t value = *p;
+                        std::memcpy(dst + k * sizeof(element_t), &value, sizeof(element_t));
+                        sid::shift(p, stride, integral_constant<int, 1>());
+                    }
+                }
+
+                void scatter(int index, char const *src) const {
+                    ptr_t p = ptr(index);
+                    auto &&stride = sid::get_stride<VerticalDim>(strides);
+                    for (int k = 0; k != levels; ++k) {
+                        element_t value;
+                        std::memcpy(&value, src + k * sizeof(element_t), sizeof(element_t));
+                        *p = value;
+                        sid::shift(p, stride, integral_constant<int, 1>());
+                    }
+                }
+            };
+        } // namespace unstructured_halo_exchange_impl_
+
+        /**
+           Halo exchange pattern for unstructured meshes.
+
+           Construction is collective over `comm`. It throws `std::runtime_error` on all ranks if a global index is
+           negative or if a ghost is not owned by any rank.
+         */
+        class unstructured_halo_exchange {
+            struct peer {
+                int rank;
+                std::vector<int> send_indices;
+                std::vector<int> recv_indices;
+                std::vector<char> send_buffer;
+                std::vector<char> recv_buffer;
+            };
+
+            MPI_Comm m_comm;
+            std::vector<peer> m_peers;
+
+            template <class Fields>
+            static std::size_t bytes_per_index(Fields const &fields) {
+                return std::apply([](auto const &...f) { return (std::size_t(0) + ... + f.bytes()); }, fields);
+            }
+
+          public:
+            /**
+               \param[in] comm Communicator of the ranks sharing the mesh
+               \param[in] global_indices Non-negative global index of each local element, owned elements first
+               \param[in] num_owned Number of owned elements
+            */
+            unstructured_halo_exchange(MPI_Comm comm, std::vector<int> const &global_indices, std::size_t num_owned) {
+                using namespace unstructured_halo_exchange_impl_;
+                assert(num_owned <= global_indices.size());
+                int size;
+                MPI_Comm_size(comm, &size);
+
+                auto negative = std::find_if(global_indices.begin(), global_indices.end(), [](int g) { return g < 0; });
+                check_on_all_ranks(comm,
+                    negative != global_indices.end(),
+                    "negative global index " + std::to_string(negative == global_indices.end() ? 0 : *negative));
+
+                // register the owned elements in the directory
+                std::vector<std::vector<int>> owned(size);
+                for (std::size_t i = 0; i != num_owned; ++i)
+                    owned[global_indices[i] % size].push_back(global_indices[i]);
+                std::unordered_map<int, int> directory;
+                auto registered = all_to_all(comm, owned);
+                for (int r = 0; r != size; ++r)
+                    for (int g : registered[r])
+                        directory[g] = r;
+
+                // ask the directory for the owners of the ghosts, -1 if there is none
+                std::vector<std::vector<int>> queries(size);
+                for (std::size_t i = num_owned; i != global_indices.size(); ++i)
+                    queries[global_indices[i] % size].push_back(global_indices[i]);
+                auto received_queries = all_to_all(comm, queries);
+                for (auto &q : received_queries)
+                    for (int &g : q) {
+                        auto it = directory.find(g);
+                        g = it == directory.end() ? -1 : it->second;
+                    }
+                auto owners = all_to_all(comm, received_queries);
+
+                // request the ghosts from their owners
+                std::vector<std::vector<int>> requests(size);
+                std::vector<std::vector<int>> recv_indices(size);
+                std::vector<std::size_t> answered(size, 0);
+                int orphan = -1;
+                for (std::size_t i = num_owned; i != global_indices.size(); ++i) {
+                    int d = global_indices[i] % size;
+                    int owner = owners[d][answered[d]++];
+                    if (owner == -1) {
+                        orphan = global_indices[i];
+                        break;
+                    }
+                    requests[owner].push_back(global_indices[i]);
+                    recv_indices[owner].push_back(i);
+                }
+                check_on_all_ranks(comm, orphan != -1, "ghost with global index " + std::to_string(orphan) +
+                                                           " is not owned by any rank");
+                auto received_requests = all_to_all(comm, requests);
+                std::unordered_map<int, int> global_to_local;
+                for (std::size_t i = 0; i != num_owned; ++i)
+                    global_to_local[global_indices[i]] = i;
+                for (int r = 0; r != size; ++r) {
+                    if (received_requests[r].empty() && recv_indices[r].empty())
+                        continue;
+                    peer p{r, std::move(received_requests[r]), std::move(recv_indices[r]), {}, {}};
+                    for (int &g : p.send_indices) {
+                        auto it = global_to_local.find(g);
+                        if (it == global_to_local.end())
+                            throw std::runtime_error("unstructured_halo_exchange: global index " + std::to_string(g) +
+                                                     " requested by rank " + std::to_string(r) +
+                                                     " is not owned by this rank");
+                        g = it->second;
+                    }
+                    m_peers.push_back(std::move(p));
+                }
+                MPI_Comm_dup(comm, &m_comm);
+            }
+
+            unstructured_halo_exchange(unstructured_halo_exchange const &) = delete;
+            unstructured_halo_exchange &operator=(unstructured_halo_exchange const &) = delete;
+
+            ~unstructured_halo_exchange() { MPI_Comm_free(&m_comm); }
+
+            /** Number of ranks this rank communicates with. */
+            std::size_t num_peers() const { return m_peers.size(); }
+
+            /** Number of local elements sent to all peers. */
+            std::size_t num_send_indices() const {
+                std::size_t res = 0;
+                for (auto const &p : m_peers)
+                    res += p.send_indices.size();
+                return res;
+            }
+
+            /** Number of ghosts received from all peers. */
+            std::size_t num_recv_indices() const {
+                std::size_t res = 0;
+                for (auto const &p : m_peers)
+                    res += p.recv_indices.size();
+                return res;
+            }
+
+            /**
+               Updates the ghosts of all the fields with the values of their owners. Collective over the peers.
+
+               \tparam HorizontalDim Dimension of the fields indexed by the local element index
+               \tparam VerticalDim Dimension of the vertical levels, the fields may lack it
+               \param[in] fields SIDs, possibly with different element types
+            */
+            template <class HorizontalDim = integral_constant<int, 0>,
+                class VerticalDim = integral_constant<int, 1>,
+                class... Fields>
+            void exchange(Fields &&...fields) {
+                using namespace unstructured_halo_exchange_impl_;
+                std::tuple<field<HorizontalDim, VerticalDim, std::remove_reference_t<Fields>>...> infos(fields...);
+                std::size_t bytes = bytes_per_index(infos);
+                if (bytes == 0)
+                    return;
+                std::vector<MPI_Request> recv_requests(m_peers.size()), send_requests(m_peers.size());
+                for (std::size_t i = 0; i != m_peers.size(); ++i) {
+                    peer &p = m_peers[i];
+                    p.recv_buffer.resize(p.recv_indices.size() * bytes);
+                    MPI_Irecv(
+                        p.recv_buffer.data(), p.recv_buffer.size(), MPI_CHAR, p.rank, 0, m_comm, &recv_requests[i]);
+                }
+                for (std::size_t i = 0; i != m_peers.size(); ++i) {
+                    peer &p = m_peers[i];
+                    p.send_buffer.resize(p.send_indices.size() * bytes);
+                    int n = p.send_indices.size();
+#pragma omp parallel for
+                    for (int j = 0; j < n; ++j) {
+                        char *dst = p.send_buffer.data() + j * bytes;
+                        std::apply(
+                            [&](auto const &...f) { ((f.gather(p.send_indices[j], dst), dst += f.bytes()), ...); },
+                            infos);
+                    }
+                    MPI_Isend(
+                        p.send_buffer.data(), p.send_buffer.size(), MPI_CHAR, p.rank, 0, m_comm, &send_requests[i]);
+                }
+                for (std::size_t count = 0; count != m_peers.size(); ++count) {
+                    int i;
+                    MPI_Waitany(recv_requests.size(), recv_requests.data(), &i, MPI_STATUS_IGNORE);
+                    peer const &p = m_peers[i];
+                    int n = p.recv_indices.size();
+#pragma omp parallel for
+                    for (int j = 0; j < n; ++j) {
+                        char const *src = p.recv_buffer.data() + j * bytes;
+                        std::apply(
+                            [&](auto const &...f) { ((f.scatter(p.recv_indices[j], src), src += f.bytes()), ...); },
+                            infos);
+                    }
+                }
+                MPI_Waitall(send_requests.size(), send_requests.data(), MPI_STATUSES_IGNORE);
+            }
+        };
+    } // namespace gcl
+} // namespace gridtools
@@ -20,6 +20,7 @@
 
 #include "../common/defs.hpp"
 #include "../common/host_device.hpp"
+#include "../common/memory_accounting.hpp"
 #include "../meta.hpp"
 #include "simple_ptr_holder.hpp"
 
@@ -69,19 +70,32 @@ namespace gridtools {
                 using ptr_t = std::unique_ptr<T, Deleter>;
                 using stack_t = std::stack<ptr_t>;
 
+                // the cached buffers are accounted as `allocator_cache` until they are reused or released
+                struct stack_map_t : std::map<size_t, stack_t> {
+                    ~stack_map_t() {
+                        for (auto const &item : *this)
+                            memory_accounting::deallocated(
+                                memory_accounting::category::allocator_cache, item.first * item.second.size());
+                    }
+                };
+
                 struct deleter_f {
                     using pointer = typename ptr_t::pointer;
                     Deleter m_deleter;
                     stack_t &m_stack;
+                    size_t m_size;
 
-                    void operator()(pointer ptr) const { m_stack.emplace(ptr, m_deleter); }
+                    void operator()(pointer ptr) const {
+                        m_stack.emplace(ptr, m_deleter);
+                        memory_accounting::allocated(memory_accounting::category::allocator_cache, m_size);
+                    }
                 };
                 using cached_ptr_t = std::unique_ptr<T, deleter_f>;
 
                 Impl m_impl;
 
                 cached_ptr_t operator()(size_t size) const {
-                    static thread_local std::map<size_t, stack_t> stack_map;
+                    static thread_local stack_map_t stack_map;
                     auto &stack = stack_map[size];
                     ptr_t ptr;
                     if (stack.empty()) {
@@ -89,8 +103,9 @@ namespace gridtools {
                     } else {
                         ptr = std::move(stack.top());
                         stack.pop();
+                        memory_accounting::deallocated(memory_accounting::category::allocator_cache, size);
                     }
-                    return {ptr.release(), {ptr.get_deleter(), stack}};
+                    return {ptr.release(), {ptr.get_deleter(), stack, size}};
                 }
             };
         } // namespace allocator_impl_
@@ -114,6 +129,7 @@ namespace gridtools {
             class allocator<Impl, std::unique_ptr<T, Deleter>> {
                 Impl m_impl;
                 std::vector<std::unique_ptr<T, Deleter>> m_buffers;
+                memory_accounting::record m_record{memory_accounting::category::temporaries};
 
               public:
                 allocator() = default;
@@ -122,8 +138,8 @@ namespace gridtools {
                 template <class LazyT>
                 friend auto allocate(allocator &self, LazyT, size_t size) {
                     using type = typename LazyT::type;
-                    auto ptr = self.m_impl(sizeof(type) * size);
                     self.m_buffers.push_back(self.m_impl(sizeof(type) * size));
+                    self.m_record.add(sizeof(type) * size);
                     return simple_ptr_holder(reinterpret_cast<type *>(self.m_buffers.back().get()));
                 }
             };
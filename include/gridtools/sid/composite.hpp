@@ -164,10 +164,16 @@ namespace gridtools {
                 struct composite_ptr;
                 template <class...>
                 struct composite_ptr_holder;
+                template <class, class, class...>
+                struct indexed_ptr;
+                template <class, class, class...>
+                struct indexed_ptr_holder;
                 template <class>
                 struct compressed;
                 template <class...>
                 struct values;
+                template <class...>
+                struct indexed_values;
 #if !defined(__NVCC__) && defined(__clang__) && __clang_major__ <= 17
                 template <class... Sids>
                 values(Sids const &...) -> values<Sids...>;
@@ -177,6 +183,10 @@ namespace gridtools {
                 static constexpr GT_FUNCTION values<Args...> make_values(Args &&...args) {
                     return {std::forward<Args>(args)...};
                 }
+                template <class... Args>
+                static constexpr GT_FUNCTION indexed_values<Args...> make_indexed_values(Args &&...args) {
+                    return {std::forward<Args>(args)...};
+                }
             };
 
             template <class... Keys>
@@ -253,6 +263,64 @@ namespace gridtools {
                 friend keys hymap_get_keys(composite_ptr_holder const &) { return {}; }
             };
 
+            /**
+             *  The pointer of `indexed_values`.
+             *
+             *  Holds the origins of the fields and one running offset of type `PtrDiff` per strides kind. Shifts only
+             *  update the offsets, the pointer of a field is computed when it is accessed.
+             *  `Compressed` is the `compressed` instantiation that maps the fields to their offsets.
+             */
+            template <class... Keys>
+            template <class Compressed, class PtrDiff, class... Ptrs>
+            struct keys<Keys...>::indexed_ptr {
+                static_assert(sizeof...(Keys) == sizeof...(Ptrs), GT_INTERNAL_ERROR);
+
+                composite_ptr<Ptrs...> m_base;
+                PtrDiff m_offsets;
+
+                struct getter {
+                    template <size_t I>
+                    static constexpr GT_FUNCTION auto get(indexed_ptr const &obj) {
+                        return tuple_util::host_device::get<I>(obj.m_base) + Compressed::template get<I>(obj.m_offsets);
+                    }
+                };
+                friend getter tuple_getter(indexed_ptr const &) { return {}; }
+                friend meta::list<Ptrs...> tuple_to_types(indexed_ptr const &) { return {}; }
+                friend meta::ctor<composite_ptr<Ptrs...>> tuple_from_types(indexed_ptr const &) { return {}; }
+
+                constexpr GT_FUNCTION decltype(auto) operator*() const { return *(m_base + m_offsets); }
+
+                friend GT_FUNCTION indexed_ptr operator+(indexed_ptr lhs, PtrDiff const &rhs) {
+                    shift(lhs.m_offsets, rhs, integral_constant<int, 1>());
+                    return lhs;
+                }
+
+                template <class Stride, class Offset>
+                friend GT_FUNCTION void sid_shift(indexed_ptr &ptr, Stride &&stride, Offset offset) {
+                    shift(ptr.m_offsets, std::forward<Stride>(stride), offset);
+                }
+
+                friend keys hymap_get_keys(indexed_ptr const &) { return {}; }
+            };
+
+            template <class... Keys>
+            template <class Compressed, class PtrDiff, class... PtrHolders>
+            struct keys<Keys...>::indexed_ptr_holder {
+                composite_ptr_holder<PtrHolders...> m_base;
+
+                template <class... Ptrs>
+                static constexpr GT_FUNCTION indexed_ptr<Compressed, PtrDiff, Ptrs...> make_ptr(
+                    composite_ptr<Ptrs...> base) {
+                    return {std::move(base), PtrDiff()};
+                }
+
+                constexpr GT_FUNCTION auto operator()() const { return make_ptr(m_base()); }
+
+                friend indexed_ptr_holder operator+(indexed_ptr_holder const &lhs, PtrDiff const &rhs) {
+                    return {lhs.m_base + rhs};
+                }
+            };
+
             /**
              *  Implements strides and ptr_diffs compression based on skipping the objects of the
              *  same kind.
@@ -466,6 +534,32 @@ namespace gridtools {
                 friend keys hymap_get_keys(values const &) { return {}; }
             };
 
+            /**
+             *  A composite with the single index addressing mode.
+             *
+             *  The pointer of `values` holds a pointer per field and every shift updates all of them. Here the fields
+             *  of the same strides kind share one running offset (of the `ptr_diff` type), which is added to the origin
+             *  of the field only when its pointer is accessed. This reduces the number of registers that are updated in
+             *  the innermost loops of wide composites, if most of the fields share a few strides kinds. The pointer
+             *  models the `hymap` concept, but its elements are computed on access and can not be modified.
+             */
+            template <class... Keys>
+            template <class... Sids>
+            struct keys<Keys...>::indexed_values : values<Sids...> {
+                using values<Sids...>::values;
+
+                indexed_values() = default;
+
+                using ptr_diff_t = typename values<Sids...>::ptr_diff_t;
+                using ptr_holder_t = indexed_ptr_holder<typename values<Sids...>::compressed_t,
+                    ptr_diff_t,
+                    ptr_holder_type<Sids>...>;
+
+                friend ptr_holder_t sid_get_origin(indexed_values &obj) {
+                    return {get_origin(static_cast<values<Sids...> &>(obj))};
+                }
+            };
+
             template <>
             template <>
             struct keys<>::values<> {
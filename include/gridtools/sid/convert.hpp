@@ -0,0 +1,120 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "../common/const_ptr_deref.hpp"
+#include "../common/host_device.hpp"
+#include "concept.hpp"
+#include "delegate.hpp"
+
+namespace gridtools {
+    namespace sid {
+        namespace convert_impl_ {
+            /**
+             *  Reference to an element stored as `T` that is read and written as `Compute`.
+             */
+            template <class Compute, class T>
+            struct converting_ref {
+                T *m_ptr;
+
+                GT_FUNCTION operator Compute() const { return static_cast<Compute>(*m_ptr); }
+
+                GT_FUNCTION converting_ref const &operator=(Compute const &src) const {
+                    *m_ptr = src;
+                    return *this;
+                }
+
+                GT_FUNCTION converting_ref const &operator=(converting_ref const &src) const {
+                    return *this = static_cast<Compute>(src);
+                }
+
+                GT_FUNCTION converting_ref const &operator+=(Compute const &src) const { return *this = *this + src; }
+                GT_FUNCTION converting_ref const &operator-=(Compute const &src) const { return *this = *this - src; }
+                GT_FUNCTION converting_ref const &operator*=(Compute const &src) const { return *this = *this * src; }
+                GT_FUNCTION converting_ref const &operator/=(Compute const &src) const { return *this = *this / src; }
+            };
+
+            template <class Compute, class Ptr, class T = std::remove_reference_t<decltype(*std::declval<Ptr>())>>
+            GT_FUNCTION std::enable_if_t<std::is_const_v<T>, Compute> deref(Ptr const &ptr) {
+                return static_cast<Compute>(const_ptr_deref(ptr));
+            }
+
+            template <class Compute, class Ptr, class T = std::remove_reference_t<decltype(*std::declval<Ptr>())>>
+            GT_FUNCTION std::enable_if_t<!std::is_const_v<T>, converting_ref<Compute, T>> deref(Ptr const &ptr) {
+                return {&*ptr};
+            }
+
+            template <class Compute, class Ptr>
+            struct converting_ptr {
+                Ptr m_ptr;
+
+                GT_FUNCTION decltype(auto) operator*() const { return deref<Compute>(m_ptr); }
+
+                template <class PtrDiff, class = decltype(std::declval<Ptr &>() += std::declval<PtrDiff const &>())>
+                friend GT_FUNCTION converting_ptr &operator+=(converting_ptr &lhs, PtrDiff const &rhs) {
+                    lhs.m_ptr += rhs;
+                    return lhs;
+                }
+
+                template <class PtrDiff, class = decltype(std::declval<Ptr &>() += std::declval<PtrDiff const &>())>
+                friend GT_FUNCTION converting_ptr operator+(converting_ptr lhs, PtrDiff const &rhs) {
+                    lhs.m_ptr += rhs;
+                    return lhs;
+                }
+            };
+
+            template <class Compute, class PtrHolder>
+            struct converting_ptr_holder {
+                PtrHolder m_impl;
+
+                GT_FUNCTION auto operator()() const {
+                    return converting_ptr<Compute, std::decay_t<decltype(m_impl())>>{m_impl()};
+                }
+
+                template <class PtrDiff>
+                friend converting_ptr_holder operator+(converting_ptr_holder const &obj, PtrDiff const &arg) {
+                    return {obj.m_impl + arg};
+                }
+            };
+
+            template <class Compute, class Sid>
+            struct converting_sid : delegate<Sid> {
+                friend converting_ptr_holder<Compute, ptr_holder_type<Sid>> sid_get_origin(converting_sid const &obj) {
+                    return {get_origin(const_cast<Sid &>(obj.m_impl))};
+                }
+                friend ptr_diff_type<Sid> sid_get_ptr_diff(converting_sid const &) { return {}; }
+                using delegate<Sid>::delegate;
+            };
+        } // namespace convert_impl_
+
+        /**
+         *  Returns a SID that keeps the elements of `sid` in memory but reads and writes them as `Compute`.
+         *
+         *  Dereferencing a pointer to const elements returns a `Compute` value, otherwise a proxy is returned that
+         *  converts to `Compute` and converts the assigned values back to the element type. This allows to store large
+         *  fields in a reduced precision (`float` or the 16 bit types of `common/float16.hpp`) to save memory
+         *  bandwidth, while the stencils compute in full precision:
+         *
+         *  \code
+         *  auto in = builder.type<bfloat16_t const>().initializer(...).build();
+         *  run(spec, backend, grid, sid::convert<double>(in), out);
+         *  \endcode
+         *
+         *  The strides, the bounds and the pointer arithmetic are the ones of `sid`.
+         */
+        template <class Compute, class Sid>
+        convert_impl_::converting_sid<Compute, Sid> convert(Sid &&sid) {
+            return {std::forward<Sid>(sid)};
+        }
+    } // namespace sid
+} // namespace gridtools
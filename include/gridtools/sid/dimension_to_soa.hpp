@@ -0,0 +1,124 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "../common/const_ptr_deref.hpp"
+#include "../common/host_device.hpp"
+#include "../common/hymap.hpp"
+#include "../common/integral_constant.hpp"
+#include "concept.hpp"
+#include "delegate.hpp"
+
+namespace gridtools {
+    namespace sid {
+        namespace dimension_to_soa_impl_ {
+            /**
+             *  Pointer to a tuple-like element whose components are stored in planes `Stride` apart.
+             *
+             *  In contrast to the composite created by `dimension_to_tuple_like`, only one pointer is kept and
+             *  shifted, the component pointers are computed on dereferencing.
+             */
+            template <class Ptr, class Stride, class Is>
+            struct soa_ptr;
+
+            template <class Ptr, class Stride, std::size_t... Is>
+            struct soa_ptr<Ptr, Stride, std::index_sequence<Is...>> {
+                Ptr m_ptr;
+                Stride m_stride;
+
+                template <int I>
+                GT_FUNCTION decltype(auto) component() const {
+                    return const_ptr_deref(sid::shifted(m_ptr, m_stride, integral_constant<int, I>()));
+                }
+
+                GT_FUNCTION auto operator*() const {
+                    using keys_t = hymap::keys<integral_constant<int, Is>...>;
+                    return typename keys_t::template values<decltype(component<Is>())...>(component<Is>()...);
+                }
+
+                template <class PtrDiff, class = decltype(std::declval<Ptr &>() += std::declval<PtrDiff const &>())>
+                friend GT_FUNCTION soa_ptr &operator+=(soa_ptr &lhs, PtrDiff const &rhs) {
+                    lhs.m_ptr += rhs;
+                    return lhs;
+                }
+
+                template <class PtrDiff, class = decltype(std::declval<Ptr &>() += std::declval<PtrDiff const &>())>
+                friend GT_FUNCTION soa_ptr operator+(soa_ptr lhs, PtrDiff const &rhs) {
+                    lhs.m_ptr += rhs;
+                    return lhs;
+                }
+            };
+
+            template <class PtrHolder, class Stride, class Is>
+            struct soa_ptr_holder {
+                PtrHolder m_ptr_holder;
+                Stride m_stride;
+
+                GT_FUNCTION auto operator()() const {
+                    return soa_ptr<std::decay_t<decltype(m_ptr_holder())>, Stride, Is>{m_ptr_holder(), m_stride};
+                }
+
+                template <class PtrDiff>
+                friend soa_ptr_holder operator+(soa_ptr_holder const &obj, PtrDiff const &arg) {
+                    return {obj.m_ptr_holder + arg, obj.m_stride};
+                }
+            };
+
+            template <class Dim, class Kind>
+            struct soa_strides_kind;
+
+            template <class Dim, std::size_t N, class Sid>
+            struct soa_sid : sid::delegate<Sid> {
+                using stride_t = std::decay_t<decltype(sid::get_stride<Dim>(std::declval<sid::strides_type<Sid>>()))>;
+
+                friend soa_ptr_holder<sid::ptr_holder_type<Sid const>, stride_t, std::make_index_sequence<N>>
+                sid_get_origin(soa_sid const &obj) {
+                    return {sid::get_origin(obj.m_impl), sid::get_stride<Dim>(sid::get_strides(obj.m_impl))};
+                }
+                friend sid::ptr_diff_type<Sid> sid_get_ptr_diff(soa_sid const &) { return {}; }
+                friend decltype(hymap::canonicalize_and_remove_key<Dim>(std::declval<sid::strides_type<Sid>>()))
+                sid_get_strides(soa_sid const &obj) {
+                    return hymap::canonicalize_and_remove_key<Dim>(sid::get_strides(obj.m_impl));
+                }
+                friend soa_strides_kind<Dim, sid::strides_kind<Sid>> sid_get_strides_kind(soa_sid const &) {
+                    return {};
+                }
+                friend decltype(hymap::canonicalize_and_remove_key<Dim>(std::declval<sid::lower_bounds_type<Sid>>()))
+                sid_get_lower_bounds(soa_sid const &obj) {
+                    return hymap::canonicalize_and_remove_key<Dim>(sid::get_lower_bounds(obj.m_impl));
+                }
+                friend decltype(hymap::canonicalize_and_remove_key<Dim>(std::declval<sid::upper_bounds_type<Sid>>()))
+                sid_get_upper_bounds(soa_sid const &obj) {
+                    return hymap::canonicalize_and_remove_key<Dim>(sid::get_upper_bounds(obj.m_impl));
+                }
+
+                using sid::delegate<Sid>::delegate;
+            };
+        } // namespace dimension_to_soa_impl_
+
+        /**
+         * Returns a SID, where `Dim` of `sid` is mapped to a tuple-like of size `N`, like `dimension_to_tuple_like`.
+         *
+         * The components are expected to be stored in separate planes (struct of arrays), i.e. `Dim` should be the
+         * slowest dimension of the layout, which is the case for the default layouts of all storage traits. Shifting
+         * the resulting SID moves a single pointer, so all components are loaded with the same (vectorizable)
+         * offsets.
+         */
+        template <class Dim, std::size_t N, class Sid>
+        dimension_to_soa_impl_::soa_sid<Dim, N, Sid> dimension_to_soa(Sid &&sid) {
+            return {std::forward<Sid>(sid)};
+        }
+    } // namespace sid
+} // namespace gridtools
@@ -11,6 +11,7 @@
 
 #include <cassert>
 #include <functional>
+#include <type_traits>
 #include <utility>
 
 #include "../../common/for_each.hpp"
@@ -33,24 +34,71 @@ namespace gridtools {
                         std::move(data_stores));
                 }
 
+                template <class Spec, class Grid, class DataStores>
+                void check_k_sizes(Grid const &grid) {
+#ifndef NDEBUG
+                    using be_spec_t = convert_fe_to_be_spec<Spec, typename Grid::interval_t, DataStores>;
+                    for_each<be_api::make_fused_view<be_spec_t>>([&](auto matrix) {
+                        for_each<decltype(matrix)>([&](auto info) {
+                            assert(((void)"domain k-size is too small", grid.k_size(info.interval()) >= 0));
+                        });
+                    });
+#endif
+                }
+
                 template <class Spec>
                 struct call_entry_point_f {
                     template <class Backend, class Grid, class DataStores>
                     void operator()(Backend &&be, Grid const &grid, DataStores data_stores) const {
                         using be_spec_t = convert_fe_to_be_spec<Spec, typename Grid::interval_t, DataStores>;
-#ifndef NDEBUG
-                        for_each<be_api::make_fused_view<be_spec_t>>([&](auto matrix) {
-                            for_each<decltype(matrix)>([&](auto info) {
-                                assert(((void)"domain k-size is too small", grid.k_size(info.interval()) >= 0));
-                            });
-                        });
-#endif
+                        check_k_sizes<Spec, Grid, DataStores>(grid);
                         gridtools_backend_entry_point(
                             std::forward<Backend>(be), be_spec_t(), grid, shift_origin(grid, std::move(data_stores)));
                     }
                 };
+
+                template <class Backend, class Spec, class Grid, class DataStores, class = void>
+                struct has_prepare : std::false_type {};
+
+                template <class Backend, class Spec, class Grid, class DataStores>
+                struct has_prepare<Backend,
+                    Spec,
+                    Grid,
+                    DataStores,
+                    std::void_t<decltype(gridtools_backend_prepare(std::declval<Backend>(),
+                        std::declval<Spec>(),
+                        std::declval<Grid const &>(),
+                        std::declval<DataStores>()))>> : std::true_type {};
+
+                /**
+                 *  Backends may implement `gridtools_backend_prepare(backend, spec, grid, data_stores)`, which does
+                 *  all the setup of `gridtools_backend_entry_point` once and returns a callable that runs the
+                 *  computation. For the other backends the prepared computation calls the entry point.
+                 */
+                template <class Spec>
+                struct call_prepare_f {
+                    template <class Backend, class Grid, class DataStores>
+                    auto operator()(Backend &&be, Grid const &grid, DataStores data_stores) const {
+                        using be_spec_t = convert_fe_to_be_spec<Spec, typename Grid::interval_t, DataStores>;
+                        using shifted_t = decltype(shift_origin(grid, std::move(data_stores)));
+                        check_k_sizes<Spec, Grid, DataStores>(grid);
+                        if constexpr (has_prepare<std::decay_t<Backend>, be_spec_t, Grid, shifted_t>::value) {
+                            return gridtools_backend_prepare(std::forward<Backend>(be),
+                                be_spec_t(),
+                                grid,
+                                shift_origin(grid, std::move(data_stores)));
+                        } else {
+                            return [be = std::forward<Backend>(be),
+                                       grid,
+                                       data_stores = shift_origin(grid, std::move(data_stores))] {
+                                gridtools_backend_entry_point(be, be_spec_t(), grid, data_stores);
+                            };
+                        }
+                    }
+                };
             } // namespace backend_impl_
             using backend_impl_::call_entry_point_f;
+            using backend_impl_::call_prepare_f;
         } // namespace core
     }     // namespace stencil
 } // namespace gridtools
@@ -88,6 +88,18 @@ namespace gridtools {
                     }
                 }
 
+                /**
+                 *  The same grid restricted to another horizontal domain, the vertical axis is kept.
+                 */
+                grid horizontal_section(int_t i_start, int_t i_size, int_t j_start, int_t j_size) const {
+                    grid res = *this;
+                    res.m_i_start = i_start;
+                    res.m_i_size = i_size;
+                    res.m_j_start = j_start;
+                    res.m_j_size = j_size;
+                    return res;
+                }
+
                 auto origin() const {
                     return hymap::keys<dim::i, dim::j, dim::k>::make_values(m_i_start, m_j_start, offset());
                 }
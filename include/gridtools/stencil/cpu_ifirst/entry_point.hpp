@@ -9,6 +9,9 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
 
@@ -32,10 +35,18 @@
 namespace gridtools {
     namespace stencil {
         namespace cpu_ifirst_backend {
-            template <class ThreadPool = thread_pool::omp>
+            // the total size of the elements of the given fields
+            template <class... PlhInfos>
+            constexpr size_t cell_bytes(meta::list<PlhInfos...>) {
+                return (sizeof(typename PlhInfos::data_t) + ... + 0);
+            }
+
+            // KPipelining enables the wavefront schedule of the k-serial stages on small horizontal domains, see
+            // run_pipelined_loops. It is off by default until it shows a speed-up on the kserial_pipeline perftest.
+            template <class ThreadPool = thread_pool::omp, class KPipelining = std::false_type>
             struct cpu_ifirst {
                 template <class Spec, class Grid, class DataStores>
-                friend void gridtools_backend_entry_point(
+                friend auto gridtools_backend_prepare(
                     cpu_ifirst, Spec, Grid const &grid, DataStores external_data_stores) {
                     using thread_pool_t = ThreadPool; // workaround needed for nvc++ at least up to 23.3
                     using stages_t = be_api::make_split_view<Spec>;
@@ -46,10 +57,35 @@ namespace gridtools {
                     using fuse_all_t =
                         std::bool_constant<all_parrallel_t::value && enclosing_extent_t::kminus::value == 0 &&
                                            enclosing_extent_t::kplus::value == 0>;
+                    constexpr bool may_pipeline = KPipelining::value && !fuse_all_t::value &&
+                                                  std::is_same<thread_pool_t, thread_pool::omp>::value &&
+                                                  can_pipeline<stages_t>();
+                    constexpr int_t num_stages = meta::length<stages_t>::value;
+                    constexpr int_t k_reach =
+                        std::max(-enclosing_extent_t::kminus::value, enclosing_extent_t::kplus::value);
+                    constexpr int_t k_lag = (k_reach + pipeline_k_chunk_size - 1) / pipeline_k_chunk_size;
+
+                    // The stages that are not fused are run block by block, the blocks are sized to keep the
+                    // columns of all the fields in cache from one stage to the next.
+                    // the temporaries hold one block per thread
+                    int_t threads = thread_pool::get_max_threads(thread_pool_t());
+
+                    execinfo info(thread_pool_t(),
+                        grid,
+                        fuse_all_t::value ? 0 : cell_bytes(meta::rename<meta::list, typename stages_t::plh_map_t>()) *
+                                                    grid.k_size());
 
-                    tmp_allocator alloc;
+                    // On small horizontal domains there are more threads than columns of blocks. The k-serial stages
+                    // are then pipelined along k, see run_pipelined_loops.
+                    bool pipelined = false;
+                    if constexpr (may_pipeline) {
+                        if (threads > 1 && info.i_blocks() > 1 && grid.k_size() > pipeline_k_chunk_size) {
+                            info = execinfo(grid, (threads + num_stages - 1) / num_stages);
+                            pipelined = true;
+                        }
+                    }
 
-                    execinfo info(thread_pool_t(), grid);
+                    auto alloc = std::make_shared<tmp_allocator>();
 
                     using tmp_plh_map_t = be_api::remove_caches_from_plh_map<typename stages_t::tmp_plh_map_t>;
                     auto temporaries = be_api::make_data_stores(tmp_plh_map_t(),
@@ -60,7 +96,7 @@ namespace gridtools {
                             return make_tmp_storage<decltype(info.data()),
                                 decltype(info.extent()),
                                 fuse_all_t::value,
-                                thread_pool_t>(alloc, block_size);
+                                thread_pool_t>(*alloc, block_size);
                         });
 
                     auto blocked_externals = tuple_util::transform(
@@ -70,7 +106,9 @@ namespace gridtools {
                         },
                         std::move(external_data_stores));
 
-                    auto data_stores = hymap::concat(std::move(blocked_externals), std::move(temporaries));
+                    // the data stores are not moved after the loops are made, some SIDs own the data they point to
+                    auto data_stores = std::make_shared<decltype(hymap::concat(blocked_externals, temporaries))>(
+                        hymap::concat(std::move(blocked_externals), std::move(temporaries)));
 
                     auto loops = tuple_util::transform(
                         [&](auto stage) {
@@ -82,7 +120,7 @@ namespace gridtools {
                             using keys_t = meta::rename<sid::composite::keys, meta::transform<meta::first, plh_map_t>>;
                             auto composite = tuple_util::convert_to<keys_t::template values>(tuple_util::transform(
                                 [&](auto info) {
-                                    return sid::add_const(info.is_const(), at_key<decltype(info.plh())>(data_stores));
+                                    return sid::add_const(info.is_const(), at_key<decltype(info.plh())>(*data_stores));
                                 },
                                 stage_t::plh_map()));
                             return make_loop<thread_pool_t, stage_t>(
@@ -90,7 +128,26 @@ namespace gridtools {
                         },
                         meta::rename<tuple, stages_t>());
 
-                    run_loops<thread_pool_t>(fuse_all_t(), grid, std::move(loops));
+                    return [alloc = std::move(alloc),
+                               data_stores = std::move(data_stores),
+                               loops = std::move(loops),
+                               grid,
+                               info,
+                               pipelined,
+                               threads] {
+                        if (thread_pool::get_max_threads(thread_pool_t()) > threads)
+                            throw std::runtime_error("cpu_ifirst: the computation was prepared for fewer threads");
+                        if constexpr (may_pipeline)
+                            if (pipelined)
+                                return run_pipelined_loops<stages_t>(grid, info, k_lag, loops);
+                        run_loops<thread_pool_t>(fuse_all_t(), grid, info, loops);
+                    };
+                }
+
+                template <class Spec, class Grid, class DataStores>
+                friend void gridtools_backend_entry_point(
+                    cpu_ifirst be, Spec spec, Grid const &grid, DataStores external_data_stores) {
+                    gridtools_backend_prepare(be, spec, grid, std::move(external_data_stores))();
                 }
             };
         } // namespace cpu_ifirst_backend
@@ -10,6 +10,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
 #include "../../common/defs.hpp"
 #include "../../common/host_device.hpp"
 #include "../../thread_pool/concept.hpp"
@@ -44,6 +48,10 @@ namespace gridtools {
              * @brief Helper class for block handling.
              */
             class execinfo {
+                // the amount of data of a block that is kept in cache from one stage to the next
+                static constexpr size_t block_cache_bytes = 1024 * 1024;
+                static constexpr int_t min_j_block_size = 8;
+
                 int_t m_i_grid_size, m_j_grid_size;
                 int_t m_i_block_size, m_j_block_size;
                 int_t m_i_blocks, m_j_blocks;
@@ -55,9 +63,21 @@ namespace gridtools {
 
               public:
                 template <class ThreadPool, class Grid>
-                GT_FORCE_INLINE execinfo(ThreadPool, const Grid &grid)
+                GT_FORCE_INLINE execinfo(ThreadPool, const Grid &grid, size_t column_bytes = 0)
+                    : execinfo(grid, thread_pool::get_max_threads(ThreadPool()), column_bytes) {}
+
+                /**
+                 * @brief Splits the domain into (at most) the given number of blocks.
+                 *
+                 * If the size in bytes of a full column of all the fields is given, the blocks are further split
+                 * along the j-axis until the columns of a block fit into block_cache_bytes, so that the stages of
+                 * a block reuse the data of the previous ones from cache. The blocks keep at least
+                 * min_j_block_size rows to bound the redundant computations on the halos of the temporaries.
+                 */
+                template <class Grid>
+                GT_FORCE_INLINE execinfo(const Grid &grid, int_t threads, size_t column_bytes = 0)
                     : m_i_grid_size(grid.i_size()), m_j_grid_size(grid.j_size()) {
-                    int_t threads = thread_pool::get_max_threads(ThreadPool());
+                    assert(threads > 0);
 
                     // if domain is large enough (relative to the number of threads),
                     // we split only along j-axis (for prefetching reasons)
@@ -68,6 +88,15 @@ namespace gridtools {
                     m_i_block_size = (m_i_grid_size + max_i_blocks - 1) / max_i_blocks;
                     m_i_blocks = (m_i_grid_size + m_i_block_size - 1) / m_i_block_size;
 
+                    if (column_bytes > 0) {
+                        int_t max_j_block_size = std::max(
+                            min_j_block_size, int_t(block_cache_bytes / (column_bytes * m_i_block_size)));
+                        if (m_j_block_size > max_j_block_size) {
+                            m_j_block_size = max_j_block_size;
+                            m_j_blocks = (m_j_grid_size + m_j_block_size - 1) / m_j_block_size;
+                        }
+                    }
+
                     assert(m_i_block_size > 0 && m_j_block_size > 0);
                 }
 
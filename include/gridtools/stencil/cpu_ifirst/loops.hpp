@@ -9,6 +9,11 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
@@ -20,6 +25,7 @@
 #include "../../sid/concept.hpp"
 #include "../../thread_pool/concept.hpp"
 #include "../common/dim.hpp"
+#include "../core/execution_types.hpp"
 #include "execinfo.hpp"
 
 namespace gridtools {
@@ -58,6 +64,28 @@ namespace gridtools {
                     return {i_size, ptr, strides};
                 }
 
+                // runs the levels [m_k_from, m_k_to) of the stage, counted in the order of execution
+                template <class Ptr, class Strides>
+                struct k_i_range_loops_f {
+                    int_t m_i_size;
+                    int_t m_k_from;
+                    int_t m_k_to;
+                    int_t &m_k_pos;
+                    Ptr &m_ptr;
+                    Strides const &m_strides;
+
+                    template <class Cell, class KSize>
+                    GT_FORCE_INLINE void operator()(Cell cell, KSize k_size) const {
+                        int_t from = std::max(m_k_from, m_k_pos);
+                        int_t to = std::min(m_k_to, m_k_pos + k_size);
+                        for (int_t k = from; k < to; ++k) {
+                            i_loop(m_i_size, cell, m_ptr, m_strides);
+                            cell.inc_k(m_ptr, m_strides);
+                        }
+                        m_k_pos += k_size;
+                    }
+                };
+
                 template <class ThreadPool, class Stage, class Grid, class Composite, class KSizes>
                 auto make_loop(std::true_type, Grid const &grid, Composite composite, KSizes k_sizes) {
                     using extent_t = typename Stage::extent_t;
@@ -98,8 +126,7 @@ namespace gridtools {
                 }
 
                 template <class ThreadPool, class Grid, class Loops>
-                void run_loops(std::true_type, Grid const &grid, Loops loops) {
-                    execinfo info(ThreadPool(), grid);
+                void run_loops(std::true_type, Grid const &grid, execinfo const &info, Loops const &loops) {
                     int_t i_blocks = info.i_blocks();
                     int_t j_blocks = info.j_blocks();
                     int_t k_size = grid.k_size();
@@ -113,6 +140,16 @@ namespace gridtools {
                         j_blocks);
                 }
 
+                /**
+                 *  The position of the first level of the stage, counted from the bottom of the grid for the stages
+                 *  that are executed upwards and from the top for the ones that are executed downwards.
+                 */
+                template <class Stage, class Grid>
+                int_t k_distance(Grid const &grid) {
+                    return Stage::k_step() > 0 ? grid.k_start(Stage::interval())
+                                               : grid.k_size() - 1 - grid.k_start(Stage::interval(), core::backward());
+                }
+
                 template <class ThreadPool, class Stage, class Grid, class Composite, class KSizes>
                 auto make_loop(std::false_type, Grid const &grid, Composite composite, KSizes k_sizes) {
                     using extent_t = typename Stage::extent_t;
@@ -125,44 +162,151 @@ namespace gridtools {
                     sid::shift(
                         offset, sid::get_stride<dim::k>(strides), grid.k_start(Stage::interval(), Stage::execution()));
 
+                    // The levels that are at a distance [k_from, k_to) from the start of the grid in the direction of
+                    // execution are computed, see k_distance. The temporaries are taken from the given slot.
                     return [origin = sid::get_origin(composite) + offset,
                                strides = std::move(strides),
-                               k_shift_back = -grid.k_size(Stage::interval()) * Stage::k_step(),
-                               k_sizes = std::move(k_sizes)](execinfo_block_kserial const &info) {
+                               k_first = k_distance<Stage>(grid),
+                               k_size = grid.k_size(Stage::interval()),
+                               k_sizes = std::move(k_sizes)](
+                               execinfo_block_kserial const &info, int_t slot, int_t k_from, int_t k_to) {
+                        using namespace literals;
+                        int_t from = std::max(k_from - k_first, 0);
+                        int_t to = std::min(k_to - k_first, (int_t)k_size);
+                        if (from >= to)
+                            return;
+
                         sid::ptr_diff_type<Composite> offset{};
-                        sid::shift(
-                            offset, sid::get_stride<dim::thread>(strides), thread_pool::get_thread_num(ThreadPool()));
+                        sid::shift(offset, sid::get_stride<dim::thread>(strides), slot);
                         sid::shift(offset, sid::get_stride<sid::blocked_dim<dim::i>>(strides), info.i_block);
                         sid::shift(offset, sid::get_stride<sid::blocked_dim<dim::j>>(strides), info.j_block);
+                        sid::shift(offset, sid::get_stride<dim::k>(strides), from * Stage::k_step());
                         auto ptr = origin() + offset;
 
                         int_t j_size = extent_t::extend(dim::j(), info.j_block_size);
                         int_t i_size = extent_t::extend(dim::i(), info.i_block_size);
+                        int_t k_shift_back = (from - to) * Stage::k_step();
 
-                        auto k_i_loops = make_k_i_loops(i_size, ptr, strides);
-                        for (int_t j = 0; j < j_size; ++j) {
-                            using namespace literals;
-                            tuple_util::for_each(k_i_loops, Stage::cells(), k_sizes);
-                            sid::shift(ptr, sid::get_stride<dim::k>(strides), k_shift_back);
-                            sid::shift(ptr, sid::get_stride<dim::j>(strides), 1_c);
+                        if (from == 0 && to == k_size) {
+                            auto k_i_loops = make_k_i_loops(i_size, ptr, strides);
+                            for (int_t j = 0; j < j_size; ++j) {
+                                tuple_util::for_each(k_i_loops, Stage::cells(), k_sizes);
+                                sid::shift(ptr, sid::get_stride<dim::k>(strides), k_shift_back);
+                                sid::shift(ptr, sid::get_stride<dim::j>(strides), 1_c);
+                            }
+                        } else {
+                            for (int_t j = 0; j < j_size; ++j) {
+                                int_t k_pos = 0;
+                                tuple_util::for_each(
+                                    k_i_range_loops_f<decltype(ptr), decltype(strides)>{
+                                        i_size, from, to, k_pos, ptr, strides},
+                                    Stage::cells(),
+                                    k_sizes);
+                                sid::shift(ptr, sid::get_stride<dim::k>(strides), k_shift_back);
+                                sid::shift(ptr, sid::get_stride<dim::j>(strides), 1_c);
+                            }
                         }
                     };
                 }
 
                 template <class ThreadPool, class Grid, class Loops>
-                void run_loops(std::false_type, Grid const &grid, Loops loops) {
-                    execinfo info(ThreadPool(), grid);
+                void run_loops(std::false_type, Grid const &grid, execinfo const &info, Loops const &loops) {
+                    int_t k_size = grid.k_size();
                     thread_pool::parallel_for_loop(
                         ThreadPool(),
                         [&](auto i, auto j) {
-                            tuple_util::for_each([block = info.block(i, j)](auto &&loop) { loop(block); }, loops);
+                            tuple_util::for_each(
+                                [block = info.block(i, j), slot = thread_pool::get_thread_num(ThreadPool()), k_size](
+                                    auto &&loop) { loop(block, slot, 0, k_size); },
+                                loops);
                         },
                         info.i_blocks(),
                         info.j_blocks());
                 }
+
+                // the number of levels a stage of a pipeline computes before it signals the next stage
+                constexpr int_t pipeline_k_chunk_size = 8;
+
+                /**
+                 *  For every k-serial stage, whether it is executed in the same direction as the previous one, so that
+                 *  it can follow it level by level. The first stage has no predecessor.
+                 */
+                template <class Stages, size_t... Is>
+                constexpr std::array<bool, sizeof...(Is)> follows_previous(std::index_sequence<Is...>) {
+                    return {{(Is > 0 && decltype(meta::at_c<Stages, Is>::k_step())::value ==
+                                            decltype(meta::at_c<Stages, Is ? Is - 1 : 0>::k_step())::value)...}};
+                }
+
+                template <class Stages>
+                constexpr std::array<bool, meta::length<Stages>::value> follows_previous() {
+                    return follows_previous<Stages>(std::make_index_sequence<meta::length<Stages>::value>());
+                }
+
+                template <class Stages>
+                constexpr bool can_pipeline() {
+                    for (bool follows : follows_previous<Stages>())
+                        if (follows)
+                            return true;
+                    return false;
+                }
+
+                /**
+                 *  Wavefront schedule of k-serial stages on small horizontal domains.
+                 *
+                 *  Every pair of a block and a stage is a task. The tasks of the stages of a block run concurrently on
+                 *  different threads: a stage computes its levels in chunks of pipeline_k_chunk_size and follows the
+                 *  previous stage at a distance of `k_lag` chunks, which covers the vertical extents of the accesses.
+                 *  A stage that is executed in the opposite direction of the previous one waits for it to complete.
+                 *  The temporaries are taken from the slot of the block instead of the one of the thread.
+                 *
+                 *  The tasks are distributed round robin in the order of the stages, so a thread only waits for tasks
+                 *  with a smaller index, that are already running or completed.
+                 */
+                template <class Stages, class Grid, class Loops>
+                void run_pipelined_loops(Grid const &grid, execinfo const &info, int_t k_lag, Loops const &loops) {
+                    constexpr int_t num_stages = meta::length<Stages>::value;
+                    constexpr auto follows = follows_previous<Stages>();
+                    int_t num_chunks = (grid.k_size() + pipeline_k_chunk_size - 1) / pipeline_k_chunk_size;
+                    int_t num_blocks = info.i_blocks() * info.j_blocks();
+                    std::unique_ptr<std::atomic<int_t>[]> done(new std::atomic<int_t>[num_blocks * num_stages]);
+                    for (int_t i = 0; i < num_blocks * num_stages; ++i)
+                        done[i].store(0, std::memory_order_relaxed);
+
+#pragma omp parallel for schedule(static, 1)
+                    for (int_t task = 0; task < num_blocks * num_stages; ++task) {
+                        int_t stage = task / num_blocks;
+                        int_t block = task % num_blocks;
+                        auto block_info = info.block(block % info.i_blocks(), block / info.i_blocks());
+                        int_t index = 0;
+                        tuple_util::for_each(
+                            [&](auto &&loop) {
+                                if (index++ != stage)
+                                    return;
+                                for (int_t chunk = 0; chunk != num_chunks; ++chunk) {
+                                    if (stage > 0) {
+                                        int_t needed = follows[stage]
+                                                           ? std::min(chunk + 1 + k_lag, num_chunks)
+                                                           : num_chunks;
+                                        auto const &previous = done[task - num_blocks];
+                                        while (previous.load(std::memory_order_acquire) < needed)
+                                            std::this_thread::yield();
+                                    }
+                                    loop(block_info,
+                                        block,
+                                        chunk * pipeline_k_chunk_size,
+                                        (chunk + 1) * pipeline_k_chunk_size);
+                                    done[task].store(chunk + 1, std::memory_order_release);
+                                }
+                            },
+                            loops);
+                    }
+                }
             } // namespace loops_impl_
+            using loops_impl_::can_pipeline;
             using loops_impl_::make_loop;
+            using loops_impl_::pipeline_k_chunk_size;
             using loops_impl_::run_loops;
+            using loops_impl_::run_pipelined_loops;
         } // namespace cpu_ifirst_backend
     }     // namespace stencil
 } // namespace gridtools
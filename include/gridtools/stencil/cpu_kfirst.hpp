@@ -10,6 +10,7 @@
 #pragma once
 
 #include <memory>
+#include <stdexcept>
 #include <utility>
 
 #include "../common/defs.hpp"
@@ -91,16 +92,20 @@ namespace gridtools {
             struct cpu_kfirst {};
 
             template <class IBlockSize, class JBlockSize, class ThreadPool, class Spec, class Grid, class DataStores>
-            void gridtools_backend_entry_point(cpu_kfirst<IBlockSize, JBlockSize, ThreadPool>,
+            auto gridtools_backend_prepare(cpu_kfirst<IBlockSize, JBlockSize, ThreadPool>,
                 Spec,
                 Grid const &grid,
                 DataStores external_data_stores) {
                 using stages_t = be_api::make_split_view<Spec>;
 
-                auto alloc = sid::cached_allocator(&std::make_unique<char[]>);
+                auto alloc = std::make_shared<sid::cached_allocator<std::unique_ptr<char[]> (*)(size_t)>>(
+                    &std::make_unique<char[]>);
+
+                // the temporaries hold one block per thread
+                int_t threads = thread_pool::get_max_threads(ThreadPool());
 
                 using tmp_plh_map_t = be_api::remove_caches_from_plh_map<typename stages_t::tmp_plh_map_t>;
-                auto temporaries = be_api::make_data_stores(tmp_plh_map_t(), [&grid, &alloc](auto info) {
+                auto temporaries = be_api::make_data_stores(tmp_plh_map_t(), [&grid, &alloc, threads](auto info) {
                     auto extent = info.extent();
                     auto interval = stages_t::interval();
                     auto num_colors = info.num_colors();
@@ -111,11 +116,11 @@ namespace gridtools {
                         grid.k_size(interval, extent),
                         extent.extend(dim::j(), JBlockSize()),
                         extent.extend(dim::i(), IBlockSize()),
-                        thread_pool::get_max_threads(ThreadPool()));
+                        threads);
 
                     using stride_kind = meta::list<decltype(extent), decltype(num_colors)>;
                     return sid::shift_sid_origin(
-                        sid::make_contiguous<decltype(info.data()), int_t, stride_kind>(alloc, sizes), offsets);
+                        sid::make_contiguous<decltype(info.data()), int_t, stride_kind>(*alloc, sizes), offsets);
                 });
 
                 auto blocked_external_data_stores = tuple_util::transform(
@@ -125,11 +130,14 @@ namespace gridtools {
                     },
                     std::move(external_data_stores));
 
-                auto data_stores = hymap::concat(std::move(blocked_external_data_stores), std::move(temporaries));
+                // the data stores are not moved after the loops are made, some SIDs own the data they point to
+                auto data_stores =
+                    std::make_shared<decltype(hymap::concat(blocked_external_data_stores, temporaries))>(
+                        hymap::concat(std::move(blocked_external_data_stores), std::move(temporaries)));
 
                 auto stage_loops = tuple_util::transform(
                     [&](auto stage)
-                        GT_FORCE_INLINE_LAMBDA { return make_stage_loop(ThreadPool(), stage, grid, data_stores); },
+                        GT_FORCE_INLINE_LAMBDA { return make_stage_loop(ThreadPool(), stage, grid, *data_stores); },
                     meta::rename<tuple, stages_t>());
 
                 int_t total_i = grid.i_size();
@@ -138,16 +146,35 @@ namespace gridtools {
                 int_t NBI = (total_i + IBlockSize::value - 1) / IBlockSize::value;
                 int_t NBJ = (total_j + JBlockSize::value - 1) / JBlockSize::value;
 
-                thread_pool::parallel_for_loop(
-                    ThreadPool(),
-                    [&](auto bj, auto bi) {
-                        int_t i_size = bi + 1 == NBI ? total_i - bi * IBlockSize::value : IBlockSize::value;
-                        int_t j_size = bj + 1 == NBJ ? total_j - bj * JBlockSize::value : JBlockSize::value;
-                        tuple_util::for_each(
-                            [=](auto &&fun) GT_FORCE_INLINE_LAMBDA { fun(bi, bj, i_size, j_size); }, stage_loops);
-                    },
-                    NBJ,
-                    NBI);
+                return [alloc = std::move(alloc),
+                           data_stores = std::move(data_stores),
+                           stage_loops = std::move(stage_loops),
+                           total_i,
+                           total_j,
+                           NBI,
+                           NBJ,
+                           threads] {
+                    if (thread_pool::get_max_threads(ThreadPool()) > threads)
+                        throw std::runtime_error("cpu_kfirst: the computation was prepared for fewer threads");
+                    thread_pool::parallel_for_loop(
+                        ThreadPool(),
+                        [&](auto bj, auto bi) {
+                            int_t i_size = bi + 1 == NBI ? total_i - bi * IBlockSize::value : IBlockSize::value;
+                            int_t j_size = bj + 1 == NBJ ? total_j - bj * JBlockSize::value : JBlockSize::value;
+                            tuple_util::for_each(
+                                [=](auto &&fun) GT_FORCE_INLINE_LAMBDA { fun(bi, bj, i_size, j_size); }, stage_loops);
+                        },
+                        NBJ,
+                        NBI);
+                };
+            }
+
+            template <class IBlockSize, class JBlockSize, class ThreadPool, class Spec, class Grid, class DataStores>
+            void gridtools_backend_entry_point(cpu_kfirst<IBlockSize, JBlockSize, ThreadPool> be,
+                Spec spec,
+                Grid const &grid,
+                DataStores external_data_stores) {
+                gridtools_backend_prepare(be, spec, grid, std::move(external_data_stores))();
             }
         } // namespace cpu_kfirst_backend
         using cpu_kfirst_backend::cpu_kfirst;
@@ -17,3 +17,4 @@
 #include "frontend/make_grid.hpp"
 #include "frontend/make_param_list.hpp"
 #include "frontend/run.hpp"
+#include "frontend/run_time_steps.hpp"
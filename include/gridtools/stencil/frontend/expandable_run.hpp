@@ -10,10 +10,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <type_traits>
 #include <vector>
 
+#include "../../common/defs.hpp"
 #include "../../meta.hpp"
+#include "../../sid/concept.hpp"
+#include "../common/intent.hpp"
 #include "run.hpp"
 
 namespace gridtools {
@@ -147,7 +151,101 @@ namespace gridtools {
                     std::forward<Backend>(be), grid, make_data_store_map<Factor, Is...>(offset, fields...));
             }
 
-            template <size_t Factor, class Comp, class Backend, class Grid, class... Fields, size_t... Is>
+            template <size_t Factor, class Spec, size_t... Is, class Backend, class Grid, class... Fields>
+            void run_chunks(std::false_type, Backend &&be, Grid const &grid, size_t size, Fields const &...fields) {
+                size_t offset = 0;
+                for (; size - offset >= Factor; offset += Factor)
+                    expanded_run<Factor, Spec, Is...>(be, grid, offset, fields...);
+                for (; offset < size; ++offset)
+                    expanded_run<1, Spec, Is...>(be, grid, offset, fields...);
+            }
+
+            // The chunks are independent backend invocations that are distributed over the threads. Within a chunk
+            // the parallel loop of the backend runs on the thread of the chunk unless nested parallelism is enabled.
+            template <size_t Factor, class Spec, size_t... Is, class Backend, class Grid, class... Fields>
+            void run_chunks(std::true_type, Backend &&be, Grid const &grid, size_t size, Fields const &...fields) {
+                size_t num_full_chunks = size / Factor;
+                size_t num_chunks = num_full_chunks + size % Factor;
+#pragma omp parallel for schedule(dynamic)
+                for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+                    if (chunk < num_full_chunks)
+                        expanded_run<Factor, Spec, Is...>(be, grid, chunk * Factor, fields...);
+                    else
+                        expanded_run<1, Spec, Is...>(be, grid, chunk + num_full_chunks * (Factor - 1), fields...);
+                }
+            }
+
+            // the largest factor chosen by auto_factor
+            constexpr size_t max_auto_factor = 8;
+            // the number of expanded fields a chunk may access, more than that spills the pointers out of registers
+            constexpr size_t register_budget = 16;
+            // the number of bytes of the columns of a horizontal block of all the expanded fields of a chunk
+            constexpr size_t cache_budget = 512 * 1024;
+            // the number of columns of a horizontal block
+            constexpr size_t block_columns = 64;
+
+            template <class Field>
+            size_t get_element_size(Field const &) {
+                return 0;
+            }
+            template <class T, class A>
+            size_t get_element_size(std::vector<T, A> const &) {
+                return sizeof(sid::element_type<T>);
+            }
+
+            /**
+             *  The largest power of two up to max_auto_factor that does not exceed the number of elements and keeps
+             *  a chunk within register_budget and cache_budget.
+             */
+            template <class Grid, class... Fields>
+            size_t auto_factor(Grid const &grid, size_t size, Fields const &...fields) {
+                constexpr size_t num_expanded = (meta::is_instantiation_of<std::vector, Fields>::value + ... + 0);
+                size_t block_bytes = std::max({size_t(1), get_element_size(fields)...}) * grid.k_size() * block_columns;
+                size_t res = max_auto_factor;
+                while (res > 1 && (res > size || res * num_expanded > register_budget ||
+                                      res * num_expanded * block_bytes > cache_budget))
+                    res /= 2;
+                return res;
+            }
+
+            // Factor zero stands for the automatic choice among the powers of two up to max_auto_factor
+            template <size_t Factor,
+                class Spec,
+                size_t... Is,
+                class Concurrent,
+                class Backend,
+                class Grid,
+                class... Fields>
+            void run_factor(Concurrent concurrent, Backend &&be, Grid const &grid, Fields const &...fields) {
+                size_t size = get_expandable_size(fields...);
+                if constexpr (Factor == 0) {
+                    static_assert(max_auto_factor == 8, GT_INTERNAL_ERROR);
+                    size_t factor = auto_factor(grid, size, fields...);
+                    if (factor == 8)
+                        run_chunks<8, Spec, Is...>(concurrent, be, grid, size, fields...);
+                    else if (factor == 4)
+                        run_chunks<4, Spec, Is...>(concurrent, be, grid, size, fields...);
+                    else if (factor == 2)
+                        run_chunks<2, Spec, Is...>(concurrent, be, grid, size, fields...);
+                    else
+                        run_chunks<1, Spec, Is...>(concurrent, be, grid, size, fields...);
+                } else {
+                    run_chunks<Factor, Spec, Is...>(concurrent, be, grid, size, fields...);
+                }
+            }
+
+            template <class Spec, size_t I, class Field>
+            using is_read_only_or_expanded =
+                std::bool_constant<meta::is_instantiation_of<std::vector, std::decay_t<Field>>::value ||
+                                   decltype(frontend_impl_::get_arg_intent(Spec(), arg<I>()))::value == intent::in>;
+
+            template <size_t Factor,
+                class Concurrent,
+                class Comp,
+                class Backend,
+                class Grid,
+                class... Fields,
+                size_t... Is>
             auto run_impl(Comp comp, Backend &&be, Grid const &grid, std::index_sequence<Is...>, Fields &&...fields)
                 -> std::void_t<decltype(comp(make_arg<Is, Fields>()...))> {
                 using spec_t = decltype(comp(make_arg<Is, Fields>()...));
@@ -160,29 +258,72 @@ namespace gridtools {
                     meta::all_of<frontend_impl_::check_valid_apply_overloads<typename Grid::interval_t>::template apply,
                         functors_t>::value,
                     "Invalid stencil operator detected.");
+                static_assert(
+                    !Concurrent::value || std::conjunction_v<is_read_only_or_expanded<spec_t, Is, Fields>...>,
+                    "The fields that are not expanded are shared by the concurrent chunks and must not be written.");
 
-                size_t size = get_expandable_size(fields...);
-                size_t offset = 0;
-                for (; size - offset >= Factor; offset += Factor)
-                    expanded_run<Factor, spec_t, Is...>(be, grid, offset, fields...);
-                for (; offset < size; ++offset)
-                    expanded_run<1, spec_t, Is...>(be, grid, offset, fields...);
+                run_factor<Factor, spec_t, Is...>(Concurrent(), be, grid, fields...);
             }
 
-            template <size_t, class... Ts>
+            template <size_t, class, class... Ts>
             void run_impl(Ts...) {
                 static_assert(sizeof...(Ts) < 0, "Unexpected gridtools::stencil::expandable_run first argument.");
             }
 
+            /**
+             *  Runs the computation for all the elements of the `std::vector` arguments, `Factor` of them per
+             *  backend invocation.
+             */
             template <size_t Factor, class Comp, class Backend, class Grid, class... Fields>
             void expandable_run(Comp comp, Backend &&be, Grid const &grid, Fields &&...fields) {
-                run_impl<Factor>(comp,
+                static_assert(Factor > 0, "The expansion factor must be positive.");
+                run_impl<Factor, std::false_type>(comp,
+                    std::forward<Backend>(be),
+                    grid,
+                    std::index_sequence_for<Fields...>(),
+                    std::forward<Fields>(fields)...);
+            }
+
+            /**
+             *  Same as above with the factor chosen by auto_factor.
+             */
+            template <class Comp, class Backend, class Grid, class... Fields>
+            void expandable_run(Comp comp, Backend &&be, Grid const &grid, Fields &&...fields) {
+                run_impl<0, std::false_type>(comp,
+                    std::forward<Backend>(be),
+                    grid,
+                    std::index_sequence_for<Fields...>(),
+                    std::forward<Fields>(fields)...);
+            }
+
+            /**
+             *  Same as expandable_run, but the backend invocations of the chunks are executed concurrently by the
+             *  host threads, so that the elements of the `std::vector` arguments become an extra parallel dimension.
+             *  The arguments that are not expanded are shared by all the chunks and must be read-only.
+             */
+            template <size_t Factor, class Comp, class Backend, class Grid, class... Fields>
+            void concurrent_expandable_run(Comp comp, Backend &&be, Grid const &grid, Fields &&...fields) {
+                static_assert(Factor > 0, "The expansion factor must be positive.");
+                run_impl<Factor, std::true_type>(comp,
+                    std::forward<Backend>(be),
+                    grid,
+                    std::index_sequence_for<Fields...>(),
+                    std::forward<Fields>(fields)...);
+            }
+
+            /**
+             *  Same as above with the factor chosen by auto_factor.
+             */
+            template <class Comp, class Backend, class Grid, class... Fields>
+            void concurrent_expandable_run(Comp comp, Backend &&be, Grid const &grid, Fields &&...fields) {
+                run_impl<0, std::true_type>(comp,
                     std::forward<Backend>(be),
                     grid,
                     std::index_sequence_for<Fields...>(),
                     std::forward<Fields>(fields)...);
             }
         } // namespace expandalble_frontend_impl_
+        using expandalble_frontend_impl_::concurrent_expandable_run;
         using expandalble_frontend_impl_::expandable;
         using expandalble_frontend_impl_::expandable_run;
     } // namespace stencil
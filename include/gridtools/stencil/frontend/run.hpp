@@ -198,22 +198,18 @@ namespace gridtools {
                 using apply = core::check_valid_apply_overloads<Functor, Interval>;
             };
 
-            template <class Comp, class Backend, class Grid, class... Fields, size_t... Is>
-            auto run_impl(Comp comp, Backend &&be, Grid const &grid, std::index_sequence<Is...>, Fields &&...fields)
-                -> std::void_t<decltype(comp(arg<Is>()...))> {
-                using spec_t = decltype(comp(arg<Is>()...));
+            template <class Spec, class Grid, class... Fields, size_t... Is>
+            void check_run_args(Grid const &grid, std::index_sequence<Is...>, Fields const &...fields) {
                 static_assert(
-                    meta::is_instantiation_of<spec, spec_t>::value, "Invalid stencil composition specification.");
+                    meta::is_instantiation_of<spec, Spec>::value, "Invalid stencil composition specification.");
                 static_assert(
                     meta::is_instantiation_of<core::interval, typename Grid::interval_t>::value, "Invalid grid.");
-                using functors_t = meta::transform<meta::first, meta::flatten<meta::transform<meta::second, spec_t>>>;
+                using functors_t = meta::transform<meta::first, meta::flatten<meta::transform<meta::second, Spec>>>;
                 static_assert(meta::all_of<check_valid_apply_overloads<typename Grid::interval_t>::template apply,
                                   functors_t>::value,
                     "Invalid stencil operator detected.");
-
-                using data_store_map_t = typename hymap::keys<arg<Is>...>::template values<Fields &...>;
 #ifndef NDEBUG
-                using extent_map_t = core::get_extent_map_from_msses<spec_t>;
+                using extent_map_t = core::get_extent_map_from_msses<Spec>;
                 auto check_bounds = [origin = grid.origin(), size = grid.size()](auto arg, auto const &field) {
                     using extent_t = core::lookup_extent_map<extent_map_t, decltype(arg)>;
                     // There is no check in k-direction because at the fields may be used within subintervals
@@ -227,9 +223,17 @@ namespace gridtools {
                         });
                     return 0;
                 };
-                using loop_t = int[sizeof...(Is)];
-                (void)loop_t{check_bounds(arg<Is>(), fields)...};
+                using loop_t = int[sizeof...(Is) + 1];
+                (void)loop_t{check_bounds(arg<Is>(), fields)..., 0};
 #endif
+            }
+
+            template <class Comp, class Backend, class Grid, class... Fields, size_t... Is>
+            auto run_impl(Comp comp, Backend &&be, Grid const &grid, std::index_sequence<Is...>, Fields &&...fields)
+                -> std::void_t<decltype(comp(arg<Is>()...))> {
+                using spec_t = decltype(comp(arg<Is>()...));
+                check_run_args<spec_t>(grid, std::index_sequence<Is...>(), fields...);
+                using data_store_map_t = typename hymap::keys<arg<Is>...>::template values<Fields &...>;
                 core::call_entry_point_f<spec_t>()(std::forward<Backend>(be), grid, data_store_map_t{fields...});
             }
 
@@ -249,6 +253,58 @@ namespace gridtools {
                     std::forward<Fields>(fields)...);
             }
 
+            // C arrays are kept by reference, the other fields are copied
+            template <class Field>
+            using prepared_field_t =
+                meta::if_<std::is_array<std::remove_reference_t<Field>>, Field &, std::decay_t<Field>>;
+
+            template <class Comp,
+                class Backend,
+                class Grid,
+                class... Fields,
+                size_t... Is,
+                class Spec = decltype(std::declval<Comp>()(arg<Is>()...))>
+            auto prepare_impl(Comp, Backend &&be, Grid const &grid, std::index_sequence<Is...>, Fields &&...fields) {
+                check_run_args<Spec>(grid, std::index_sequence<Is...>(), fields...);
+                using data_store_map_t = typename hymap::keys<arg<Is>...>::template values<prepared_field_t<Fields>...>;
+                return core::call_prepare_f<Spec>()(
+                    std::forward<Backend>(be), grid, data_store_map_t{std::forward<Fields>(fields)...});
+            }
+
+            template <class... Ts>
+            void prepare_impl(Ts...) {
+                static_assert(sizeof...(Ts) < 0, "Unexpected first argument of gridtools::stencil::prepare.");
+            }
+
+            /**
+             *  Does the setup of `run(comp, be, grid, fields...)` once and returns a callable that runs the
+             *  computation.
+             *
+             *  The prepared computation keeps copies of the fields (references to C arrays) and of the grid, and owns
+             *  the temporaries. Calling it only runs the loops of the backend. For that, it relies on the data
+             *  pointers of the fields staying the same: data stores that are not host referenceable must not be
+             *  accessed on the host while the prepared computation is in use. Copies of the prepared computation
+             *  share the temporaries and must not be called concurrently. The CPU backends size the temporaries for
+             *  the maximal number of threads of the thread pool at preparation; calling the prepared computation when
+             *  more threads are available (e.g. after raising `omp_set_num_threads`) throws `std::runtime_error`.
+             *
+             *  \code
+             *  auto step = prepare(spec, backend, grid, in, out);
+             *  for (int t = 0; t < steps; ++t)
+             *      step();
+             *  \endcode
+             */
+            template <class Comp, class Backend, class Grid, class... Fields>
+            auto prepare(Comp comp, Backend &&be, Grid const &grid, Fields &&...fields) {
+                static_assert(
+                    std::conjunction<is_sid<Fields>...>::value, "All computation fields must satisfy SID concept.");
+                return prepare_impl(comp,
+                    std::forward<Backend>(be),
+                    grid,
+                    std::index_sequence_for<Fields...>(),
+                    std::forward<Fields>(fields)...);
+            }
+
             template <class F, class Backend, class Grid, class... Fields>
             void run_single_stage(F, Backend &&be, Grid const &grid, Fields &&...fields) {
                 return run([](auto... args) { return execute_parallel().stage(F(), args...); },
@@ -285,6 +341,7 @@ namespace gridtools {
         using frontend_impl_::get_arg_extent;
         using frontend_impl_::get_arg_intent;
         using frontend_impl_::multi_pass;
+        using frontend_impl_::prepare;
         using frontend_impl_::run;
         using frontend_impl_::run_single_stage;
     } // namespace stencil
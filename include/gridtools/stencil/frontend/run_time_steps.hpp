@@ -0,0 +1,256 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "../../common/defs.hpp"
+#include "../../common/hymap.hpp"
+#include "../../common/integral_constant.hpp"
+#include "../../sid/allocator.hpp"
+#include "../../sid/concept.hpp"
+#include "../../sid/contiguous.hpp"
+#include "../../sid/sid_shift_origin.hpp"
+#include "../common/dim.hpp"
+#include "../common/intent.hpp"
+#include "run.hpp"
+
+/**
+ *  @file
+ *  Temporally blocked execution of repeated time steps of a computation.
+ *
+ *  `run_time_steps(comp, backend, grid, time_steps{n}, in, out, fields...)` has the same result as applying the
+ *  computation `comp(in, out, fields...)` `n` times, where the output of a time step is the input of the next one
+ *  and the values of `in` outside of the compute domain stay fixed. Instead of streaming the whole domain through
+ *  memory for every time step, the domain is split into tiles that are advanced over all the time steps one after
+ *  the other. The intermediate time levels of a tile live in two tile local buffers that fit in cache. A tile of the
+ *  time step `s` is extended by `n - 1 - s` times the extent of `in`, so the tiles are independent of each other at
+ *  the price of the redundant computation on the overlaps.
+ */
+
+namespace gridtools {
+    namespace stencil {
+        /**
+         *  The number of time steps and the horizontal size of the tiles for run_time_steps.
+         */
+        struct time_steps {
+            int_t count;
+            int_t tile_i = 64;
+            int_t tile_j = 64;
+        };
+
+        namespace run_time_steps_impl_ {
+            // half open horizontal index range
+            struct box {
+                int_t i_begin;
+                int_t i_end;
+                int_t j_begin;
+                int_t j_end;
+
+                bool empty() const { return i_begin >= i_end || j_begin >= j_end; }
+            };
+
+            inline box intersect(box const &lhs, box const &rhs) {
+                return {std::max(lhs.i_begin, rhs.i_begin),
+                    std::min(lhs.i_end, rhs.i_end),
+                    std::max(lhs.j_begin, rhs.j_begin),
+                    std::min(lhs.j_end, rhs.j_end)};
+            }
+
+            template <class Extent>
+            box expand(box const &src, Extent, int_t times) {
+                return {src.i_begin + times * Extent::iminus::value,
+                    src.i_end + times * Extent::iplus::value,
+                    src.j_begin + times * Extent::jminus::value,
+                    src.j_end + times * Extent::jplus::value};
+            }
+
+            template <class Src, class Dst>
+            void copy_box(Src const &src, Dst &dst, box const &b, int_t k_begin, int_t k_end) {
+                if (b.empty())
+                    return;
+                auto src_origin = sid::get_origin(src);
+                auto src_strides = sid::get_strides(src);
+                auto dst_origin = sid::get_origin(dst);
+                auto dst_strides = sid::get_strides(dst);
+                for (int_t k = k_begin; k < k_end; ++k)
+                    for (int_t j = b.j_begin; j < b.j_end; ++j) {
+                        auto src_ptr = src_origin();
+                        sid::shift(src_ptr, sid::get_stride<dim::i>(src_strides), b.i_begin);
+                        sid::shift(src_ptr, sid::get_stride<dim::j>(src_strides), j);
+                        sid::shift(src_ptr, sid::get_stride<dim::k>(src_strides), k);
+                        auto dst_ptr = dst_origin();
+                        sid::shift(dst_ptr, sid::get_stride<dim::i>(dst_strides), b.i_begin);
+                        sid::shift(dst_ptr, sid::get_stride<dim::j>(dst_strides), j);
+                        sid::shift(dst_ptr, sid::get_stride<dim::k>(dst_strides), k);
+                        for (int_t i = b.i_begin; i < b.i_end; ++i) {
+                            *dst_ptr = *src_ptr;
+                            sid::shift(src_ptr, sid::get_stride<dim::i>(src_strides), integral_constant<int_t, 1>());
+                            sid::shift(dst_ptr, sid::get_stride<dim::i>(dst_strides), integral_constant<int_t, 1>());
+                        }
+                    }
+            }
+
+            // the buffer is indexed with the same coordinates as the fields, the unit stride dimension is the one of
+            // the input field
+            template <class T, class KFirst, class Allocator>
+            auto make_buffer(KFirst, Allocator &alloc, box const &b, int_t k_begin, int_t k_end) {
+                auto offsets = hymap::keys<dim::i, dim::j, dim::k>::make_values(-b.i_begin, -b.j_begin, -k_begin);
+                int_t i_size = b.i_end - b.i_begin;
+                int_t j_size = b.j_end - b.j_begin;
+                int_t k_size = k_end - k_begin;
+                if constexpr (KFirst::value)
+                    return sid::shift_sid_origin(
+                        sid::make_contiguous<T, ptrdiff_t>(
+                            alloc, hymap::keys<dim::k, dim::i, dim::j>::make_values(k_size, i_size, j_size)),
+                        offsets);
+                else
+                    return sid::shift_sid_origin(
+                        sid::make_contiguous<T, ptrdiff_t>(
+                            alloc, hymap::keys<dim::i, dim::j, dim::k>::make_values(i_size, j_size, k_size)),
+                        offsets);
+            }
+
+            template <class Comp, class Backend, class Grid, class In, class Out, class... Fields, size_t... Is>
+            void run_time_steps_impl(Comp comp,
+                Backend &&be,
+                Grid const &grid,
+                time_steps const &steps,
+                std::index_sequence<Is...>,
+                In const &in,
+                Out &&out,
+                Fields &&...fields) {
+                using frontend_impl_::arg;
+                using spec_t = decltype(comp(arg<0>(), arg<1>(), arg<Is + 2>()...));
+                static_assert(decltype(get_arg_intent(spec_t(), arg<0>()))::value == intent::in,
+                    "The input of the time step must not be written by the computation.");
+                static_assert(decltype(get_arg_intent(spec_t(), arg<1>()))::value == intent::inout,
+                    "The output of the time step must be written by the computation.");
+                static_assert(((decltype(get_arg_intent(spec_t(), arg<Is + 2>()))::value == intent::in) && ...),
+                    "The fields other than the input and the output are shared by all the tiles and time steps and "
+                    "must not be written by the computation.");
+                using extent_t = decltype(get_arg_extent(spec_t(), arg<0>()));
+                using data_t = std::remove_const_t<sid::element_type<In>>;
+                using k_first_t = is_integral_constant_of<
+                    std::decay_t<decltype(sid::get_stride<dim::k>(sid::get_strides(in)))>,
+                    1>;
+
+                assert(steps.count >= 0);
+                assert(steps.tile_i > 0 && steps.tile_j > 0);
+
+                auto origin = grid.origin();
+                box domain = {at_key<dim::i>(origin),
+                    at_key<dim::i>(origin) + grid.i_size(),
+                    at_key<dim::j>(origin),
+                    at_key<dim::j>(origin) + grid.j_size()};
+                int_t k_start = at_key<dim::k>(origin);
+                int_t k_begin = k_start + extent_t::kminus::value;
+                int_t k_end = k_start + grid.k_size() + extent_t::kplus::value;
+
+                if (steps.count == 0) {
+                    copy_box(in, out, domain, k_start, k_start + grid.k_size());
+                    return;
+                }
+                if (steps.count == 1) {
+                    run(comp,
+                        std::forward<Backend>(be),
+                        grid,
+                        in,
+                        std::forward<Out>(out),
+                        std::forward<Fields>(fields)...);
+                    return;
+                }
+
+                auto run_on = [&](box const &b, auto const &src, auto &dst) {
+                    run(comp,
+                        be,
+                        grid.horizontal_section(b.i_begin, b.i_end - b.i_begin, b.j_begin, b.j_end - b.j_begin),
+                        src,
+                        dst,
+                        fields...);
+                };
+
+                int_t n = steps.count;
+                int_t num_tiles_i = (grid.i_size() + steps.tile_i - 1) / steps.tile_i;
+                int_t num_tiles_j = (grid.j_size() + steps.tile_j - 1) / steps.tile_j;
+#pragma omp parallel for collapse(2) schedule(dynamic)
+                for (int_t tj = 0; tj < num_tiles_j; ++tj)
+                    for (int_t ti = 0; ti < num_tiles_i; ++ti) {
+                        box tile = intersect(domain,
+                            {domain.i_begin + ti * steps.tile_i,
+                                domain.i_begin + (ti + 1) * steps.tile_i,
+                                domain.j_begin + tj * steps.tile_j,
+                                domain.j_begin + (tj + 1) * steps.tile_j});
+                        box local = intersect(expand(tile, extent_t(), n), expand(domain, extent_t(), 1));
+
+                        auto alloc = sid::cached_allocator(&std::make_unique<char[]>);
+                        auto a = make_buffer<data_t>(k_first_t(), alloc, local, k_begin, k_end);
+                        auto b = make_buffer<data_t>(k_first_t(), alloc, local, k_begin, k_end);
+
+                        // the values outside of the compute domain are never written by the time steps
+                        box inner = intersect(local, domain);
+                        box boundaries[] = {
+                            intersect(local, {local.i_begin, domain.i_begin, local.j_begin, local.j_end}),
+                            intersect(local, {domain.i_end, local.i_end, local.j_begin, local.j_end}),
+                            intersect(local, {domain.i_begin, domain.i_end, local.j_begin, domain.j_begin}),
+                            intersect(local, {domain.i_begin, domain.i_end, domain.j_end, local.j_end})};
+                        for (auto &buffer : {&a, &b}) {
+                            for (auto const &boundary : boundaries)
+                                copy_box(in, *buffer, boundary, k_begin, k_end);
+                            copy_box(in, *buffer, inner, k_begin, k_start);
+                            copy_box(in, *buffer, inner, k_start + grid.k_size(), k_end);
+                        }
+
+                        run_on(intersect(expand(tile, extent_t(), n - 1), domain), in, a);
+                        for (int_t s = 1; s < n - 1; ++s) {
+                            box section = intersect(expand(tile, extent_t(), n - 1 - s), domain);
+                            if (s % 2)
+                                run_on(section, a, b);
+                            else
+                                run_on(section, b, a);
+                        }
+                        run_on(tile, n % 2 ? b : a, out);
+                    }
+            }
+        } // namespace run_time_steps_impl_
+
+        /**
+         *  Runs `steps.count` time steps of the computation `comp(in, out, fields...)` in temporally blocked tiles.
+         *
+         *  The computation must read `in` and write `out`, the other fields must be read only and are passed to every
+         *  time step as is. `in` is not modified, its values outside of the compute domain of the grid are used as
+         *  fixed boundary values for all the time steps. `out` receives the result of the last time step within the
+         *  compute domain.
+         */
+        template <class Comp, class Backend, class Grid, class In, class Out, class... Fields>
+        void run_time_steps(Comp comp,
+            Backend &&be,
+            Grid const &grid,
+            time_steps const &steps,
+            In const &in,
+            Out &&out,
+            Fields &&...fields) {
+            static_assert(std::conjunction<is_sid<In>, is_sid<Out>, is_sid<Fields>...>::value,
+                "All computation fields must satisfy SID concept.");
+            run_time_steps_impl_::run_time_steps_impl(comp,
+                std::forward<Backend>(be),
+                grid,
+                steps,
+                std::index_sequence_for<Fields...>(),
+                in,
+                std::forward<Out>(out),
+                std::forward<Fields>(fields)...);
+        }
+    } // namespace stencil
+} // namespace gridtools
@@ -31,8 +31,9 @@ namespace gridtools {
     namespace stencil {
         struct naive {
             template <class Spec, class Grid, class DataStores>
-            friend void gridtools_backend_entry_point(naive, Spec, Grid const &grid, DataStores external_data_stores) {
-                auto alloc = sid::host_device::allocator(&std::make_unique<char[]>);
+            friend auto gridtools_backend_prepare(naive, Spec, Grid const &grid, DataStores external_data_stores) {
+                auto alloc = std::make_shared<sid::host_device::allocator<std::unique_ptr<char[]> (*)(size_t)>>(
+                    &std::make_unique<char[]>);
                 using stages_t = be_api::make_split_view<Spec>;
                 using tmp_plh_map_t = be_api::remove_caches_from_plh_map<typename stages_t::tmp_plh_map_t>;
                 auto temporaries = be_api::make_data_stores(tmp_plh_map_t(), [&](auto info) {
@@ -46,34 +47,46 @@ namespace gridtools {
                         num_colors, grid.k_size(interval, extent), grid.j_size(extent), grid.i_size(extent));
                     using stride_kind = meta::list<decltype(extent), decltype(num_colors)>;
                     return sid::shift_sid_origin(
-                        sid::make_contiguous<decltype(info.data()), ptrdiff_t, stride_kind>(alloc, sizes), offsets);
+                        sid::make_contiguous<decltype(info.data()), ptrdiff_t, stride_kind>(*alloc, sizes), offsets);
                 });
-                auto data_stores = hymap::concat(external_data_stores, temporaries);
+                // the data stores are not moved after the composite is made, some SIDs own the data they point to
+                auto data_stores = std::make_shared<decltype(hymap::concat(external_data_stores, temporaries))>(
+                    hymap::concat(std::move(external_data_stores), std::move(temporaries)));
                 using plh_map_t = typename stages_t::plh_map_t;
                 using keys_t = meta::rename<sid::composite::keys, meta::transform<meta::first, plh_map_t>>;
                 auto composite = tuple_util::convert_to<keys_t::template values>(tuple_util::transform(
                     [&](auto info) {
-                        return sid::add_const(info.is_const(), at_key<decltype(info.plh())>(data_stores));
+                        return sid::add_const(info.is_const(), at_key<decltype(info.plh())>(*data_stores));
                     },
                     plh_map_t()));
-                auto origin = sid::get_origin(composite);
-                auto strides = sid::get_strides(composite);
-                for_each<stages_t>([&](auto stage) {
-                    tuple_util::for_each(
-                        [&](auto cell) {
-                            auto ptr = origin();
-                            auto extent = cell.extent();
-                            auto interval = cell.interval();
-                            sid::shift(ptr, sid::get_stride<dim::i>(strides), extent.minus(dim::i()));
-                            sid::shift(ptr, sid::get_stride<dim::j>(strides), extent.minus(dim::j()));
-                            sid::shift(ptr, sid::get_stride<dim::k>(strides), grid.k_start(interval, cell.execution()));
-                            auto i_loop = sid::make_loop<dim::i>(grid.i_size(extent));
-                            auto j_loop = sid::make_loop<dim::j>(grid.j_size(extent));
-                            auto k_loop = sid::make_loop<dim::k>(grid.k_size(interval), cell.k_step());
-                            i_loop(j_loop(k_loop(cell)))(ptr, strides);
-                        },
-                        stage.cells());
-                });
+                return [alloc = std::move(alloc),
+                           data_stores = std::move(data_stores),
+                           origin = sid::get_origin(composite),
+                           strides = sid::get_strides(composite),
+                           grid] {
+                    for_each<stages_t>([&](auto stage) {
+                        tuple_util::for_each(
+                            [&](auto cell) {
+                                auto ptr = origin();
+                                auto extent = cell.extent();
+                                auto interval = cell.interval();
+                                sid::shift(ptr, sid::get_stride<dim::i>(strides), extent.minus(dim::i()));
+                                sid::shift(ptr, sid::get_stride<dim::j>(strides), extent.minus(dim::j()));
+                                sid::shift(
+                                    ptr, sid::get_stride<dim::k>(strides), grid.k_start(interval, cell.execution()));
+                                auto i_loop = sid::make_loop<dim::i>(grid.i_size(extent));
+                                auto j_loop = sid::make_loop<dim::j>(grid.j_size(extent));
+                                auto k_loop = sid::make_loop<dim::k>(grid.k_size(interval), cell.k_step());
+                                i_loop(j_loop(k_loop(cell)))(ptr, strides);
+                            },
+                            stage.cells());
+                    });
+                };
+            }
+
+            template <class Spec, class Grid, class DataStores>
+            friend void gridtools_backend_entry_point(naive be, Spec spec, Grid const &grid, DataStores data_stores) {
+                gridtools_backend_prepare(be, spec, grid, std::move(data_stores))();
             }
         };
     } // namespace stencil
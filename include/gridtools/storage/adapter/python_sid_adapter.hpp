@@ -14,12 +14,14 @@
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <pybind11/pybind11.h>
 
@@ -263,18 +265,34 @@ namespace gridtools {
             return res;
         }
 
-        template <class T, size_t Dim, class Kind = void, size_t UnitStrideDim = size_t(-1)>
-        auto as_cuda_sid(pybind11::object const &src) {
-            static_assert(std::is_trivially_copy_constructible_v<T>,
-                "as_cuda_sid should be instantiated with the trivially copyable type");
+        // `[('', typestr)]` is what the producers write for plain arrays, its size is the one of the typestr
+        inline bool is_trivial_descr(pybind11::handle descr, pybind11::handle typestr) {
+            if (!PyList_Check(descr.ptr()) || PyList_GET_SIZE(descr.ptr()) != 1)
+                return false;
+            PyObject *item = PyList_GET_ITEM(descr.ptr(), 0);
+            if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2)
+                return false;
+            PyObject *name = PyTuple_GET_ITEM(item, 0);
+            return PyUnicode_Check(name) && PyUnicode_GET_LENGTH(name) == 0 &&
+                   PyObject_RichCompareBool(PyTuple_GET_ITEM(item, 1), typestr.ptr(), Py_EQ) == 1;
+        }
 
+        inline pybind11::dict cuda_array_interface(pybind11::handle src) {
 #if defined(__HIP__)
             // This is a custom property that has to be added manually (not provided by cupy).
             // Should be replaced by `dlpack` for uniform array interface support.
-            auto iface = src.attr("__hip_array_interface__").cast<pybind11::dict>();
+            return src.attr("__hip_array_interface__").cast<pybind11::dict>();
 #else
-            auto iface = src.attr("__cuda_array_interface__").cast<pybind11::dict>();
+            return src.attr("__cuda_array_interface__").cast<pybind11::dict>();
 #endif
+        }
+
+        template <class T, size_t Dim, class Kind = void, size_t UnitStrideDim = size_t(-1)>
+        auto as_cuda_sid(pybind11::object const &src) {
+            static_assert(std::is_trivially_copy_constructible_v<T>,
+                "as_cuda_sid should be instantiated with the trivially copyable type");
+
+            auto iface = cuda_array_interface(src);
 
             // shape
             array<size_t, Dim> shape;
@@ -329,7 +347,7 @@ namespace gridtools {
             }
 
             // descr
-            if (iface.contains("descr")) {
+            if (iface.contains("descr") && !is_trivial_descr(iface["descr"], iface["typestr"])) {
                 // descr us not used.
                 // We just fully parse it and ensure that the total size EQUALS to sizeof(T) as is prescribed
                 // by the spec. I think (anstaf) it is an error in the spec. Total size should be LESS OR EQUAL
@@ -351,10 +369,197 @@ namespace gridtools {
                 .template set<property::lower_bounds>(array<integral_constant<size_t, 0>, Dim>())
                 .template set<property::upper_bounds>(shape);
         }
+
+        // what the SID made from a buffer depends on, taken without the validation of `as_sid`
+        template <size_t Dim>
+        struct buffer_state {
+            void *ptr = nullptr;
+            pybind11::ssize_t ndim = 0;
+            pybind11::ssize_t itemsize = 0;
+            std::string format;
+            std::array<pybind11::ssize_t, Dim> shape = {};
+            std::array<pybind11::ssize_t, Dim> strides = {};
+
+            friend bool operator==(buffer_state const &lhs, buffer_state const &rhs) {
+                return lhs.ptr == rhs.ptr && lhs.ndim == rhs.ndim && lhs.itemsize == rhs.itemsize &&
+                       lhs.format == rhs.format && lhs.shape == rhs.shape && lhs.strides == rhs.strides;
+            }
+            friend bool operator!=(buffer_state const &lhs, buffer_state const &rhs) { return !(lhs == rhs); }
+        };
+
+        // the SID made from `__cuda_array_interface__` depends on its whole content, the state holds a copy
+        struct cuda_array_state {
+            pybind11::object iface;
+
+            friend bool operator==(cuda_array_state const &lhs, cuda_array_state const &rhs) {
+                return lhs.iface.equal(rhs.iface);
+            }
+            friend bool operator!=(cuda_array_state const &lhs, cuda_array_state const &rhs) { return !(lhs == rhs); }
+        };
+
+        template <class T, size_t Dim, class Kind = void, size_t UnitStrideDim = size_t(-1)>
+        struct as_sid_f {
+            auto operator()(pybind11::handle src) const {
+                return as_sid<T, Dim, Kind, UnitStrideDim>(pybind11::reinterpret_borrow<pybind11::buffer>(src));
+            }
+
+            // the flags are the ones of `pybind11::buffer::request`
+            buffer_state<Dim> state(pybind11::handle src) const {
+                Py_buffer view;
+                int flags = PyBUF_STRIDES | PyBUF_FORMAT | (std::is_const<T>() ? 0 : PyBUF_WRITABLE);
+                if (PyObject_GetBuffer(src.ptr(), &view, flags) != 0)
+                    throw pybind11::error_already_set();
+                buffer_state<Dim> res;
+                res.ptr = view.buf;
+                res.ndim = view.ndim;
+                res.itemsize = view.itemsize;
+                res.format = view.format ? view.format : "B";
+                if (view.ndim == int(Dim)) {
+                    std::copy(view.shape, view.shape + Dim, res.shape.begin());
+                    std::copy(view.strides, view.strides + Dim, res.strides.begin());
+                }
+                PyBuffer_Release(&view);
+                return res;
+            }
+        };
+
+        template <class T, size_t Dim, class Kind = void, size_t UnitStrideDim = size_t(-1)>
+        struct as_cuda_sid_f {
+            auto operator()(pybind11::handle src) const {
+                return as_cuda_sid<T, Dim, Kind, UnitStrideDim>(pybind11::reinterpret_borrow<pybind11::object>(src));
+            }
+
+            cuda_array_state state(pybind11::handle src) const {
+                PyObject *copy = PyDict_Copy(cuda_array_interface(src).ptr());
+                if (!copy)
+                    throw pybind11::error_already_set();
+                return {pybind11::reinterpret_steal<pybind11::object>(copy)};
+            }
+        };
+
+        /**
+         *  Converts all items of a python sequence (list, tuple, ...) in one call, the result is a `std::vector` of
+         *  SIDs of the same type. Useful for the expandable parameters and for the functions that take many fields.
+         */
+        template <class T, size_t Dim, class Kind = void, size_t UnitStrideDim = size_t(-1)>
+        auto as_sids(pybind11::sequence const &srcs) {
+            std::vector<decltype(as_sid_f<T, Dim, Kind, UnitStrideDim>()(srcs))> res;
+            res.reserve(pybind11::len(srcs));
+            for (auto &&item : srcs) {
+                pybind11::object src = item;
+                res.push_back(as_sid_f<T, Dim, Kind, UnitStrideDim>()(src));
+            }
+            return res;
+        }
+
+        template <class T, size_t Dim, class Kind = void, size_t UnitStrideDim = size_t(-1)>
+        auto as_cuda_sids(pybind11::sequence const &srcs) {
+            std::vector<decltype(as_cuda_sid_f<T, Dim, Kind, UnitStrideDim>()(srcs))> res;
+            res.reserve(pybind11::len(srcs));
+            for (auto &&item : srcs) {
+                pybind11::object src = item;
+                res.push_back(as_cuda_sid_f<T, Dim, Kind, UnitStrideDim>()(src));
+            }
+            return res;
+        }
+
+        /**
+         *  Cache of the validated SIDs of the recently converted python objects, keyed by object identity.
+         *
+         *  Python objects can change in place: numpy allows to assign `shape`, `strides` or `dtype` of an array. So a
+         *  hit is only taken if the object still describes the same memory: the pointer, the shape, the strides and
+         *  the format of the buffer (or the whole `__cuda_array_interface__`) must be equal to the ones at the
+         *  conversion, otherwise the object is converted and validated again. A hit saves the validation of the
+         *  format (or the parsing of `__cuda_array_interface__`) and the allocation of the SID.
+         *
+         *  The cache keeps a reference to the objects, so the identity cannot be reused by another object while the
+         *  entry exists. For the host buffers the buffer stays exported: numpy refuses to resize or reallocate such an
+         *  array in place, which is what keeps the cached pointer valid. Call `clear()` (or let the cache go) to
+         *  release the arrays. Not thread safe, the GIL must be held as for any other python API call.
+         */
+        template <class Convert>
+        class sid_cache {
+            using sid_t = decltype(Convert()(std::declval<pybind11::handle>()));
+            using state_t = decltype(Convert().state(std::declval<pybind11::handle>()));
+
+            struct entry {
+                pybind11::object src;
+                state_t state;
+                sid_t sid;
+            };
+
+            size_t m_capacity;
+            std::vector<entry> m_entries;
+
+          public:
+            explicit sid_cache(size_t capacity = 64) : m_capacity(std::max(capacity, size_t(1))) {
+                m_entries.reserve(m_capacity);
+            }
+
+            // returns a copy, the next call may reorder the entries
+            sid_t operator()(pybind11::handle src) {
+                auto state = Convert().state(src);
+                auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](auto const &entry) {
+                    return entry.src.ptr() == src.ptr();
+                });
+                if (it != m_entries.end() && it->state != state) {
+                    // changed in place, the stale entry must not outlive a failed conversion
+                    m_entries.erase(it);
+                    it = m_entries.end();
+                }
+                if (it == m_entries.end()) {
+                    auto sid = Convert()(src);
+                    if (m_entries.size() == m_capacity)
+                        m_entries.pop_back();
+                    m_entries.push_back(
+                        {pybind11::reinterpret_borrow<pybind11::object>(src), std::move(state), std::move(sid)});
+                    it = std::prev(m_entries.end());
+                }
+                // the most recently used entry goes first
+                std::rotate(m_entries.begin(), it, std::next(it));
+                return m_entries.front().sid;
+            }
+
+            size_t size() const { return m_entries.size(); }
+            void clear() { m_entries.clear(); }
+        };
+
+        /**
+         *  Runs `fun` with the GIL released, returns its result.
+         *
+         *  The SIDs should be created (and destroyed) while holding the GIL, only the backend execution runs without
+         *  it, so that other python threads can proceed meanwhile. Typical usage:
+         *  \code
+         *  m.def("copy", [](py::buffer from, py::buffer to) {
+         *      auto src = as_sid<double const, 3>(from);
+         *      auto dst = as_sid<double, 3>(to);
+         *      without_gil([&] { copy(src, dst); });
+         *  });
+         *  \endcode
+         *  If all arguments of the bound function are converted inside its body, `py::call_guard<gil_scoped_release>`
+         *  can not be used, because the conversion itself needs the GIL.
+         */
+        template <class Fun>
+        decltype(auto) without_gil(Fun &&fun) {
+            pybind11::gil_scoped_release release;
+            return std::forward<Fun>(fun)();
+        }
     } // namespace python_sid_adapter_impl_
 
     // Makes a SID from the `pybind11::buffer`.
     using python_sid_adapter_impl_::as_sid;
+    using python_sid_adapter_impl_::as_sids;
 
     using python_sid_adapter_impl_::as_cuda_sid;
+    using python_sid_adapter_impl_::as_cuda_sids;
+
+    using python_sid_adapter_impl_::without_gil;
+
+    template <class T, size_t Dim, class Kind = void, size_t UnitStrideDim = size_t(-1)>
+    using sid_cache =
+        python_sid_adapter_impl_::sid_cache<python_sid_adapter_impl_::as_sid_f<T, Dim, Kind, UnitStrideDim>>;
+
+    template <class T, size_t Dim, class Kind = void, size_t UnitStrideDim = size_t(-1)>
+    using cuda_sid_cache =
+        python_sid_adapter_impl_::sid_cache<python_sid_adapter_impl_::as_cuda_sid_f<T, Dim, Kind, UnitStrideDim>>;
 } // namespace gridtools
@@ -0,0 +1,194 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "../common/array.hpp"
+
+/**
+ *  @file
+ *  Parallel bulk operations on the host memory of data stores.
+ *
+ *  The elements are visited row by row along the innermost (unit stride) dimension of the layout, so that the padding
+ *  is skipped, the multi dimensional indices are computed once per row and the inner loops are vectorized.
+ *  The data stores of one operation must have the same lengths but may have different layouts.
+ */
+
+namespace gridtools {
+    namespace storage {
+        namespace algorithm_impl_ {
+            // the rows are split into chunks of this size to keep all threads busy if there are only a few rows
+            constexpr int chunk_size = 4096;
+
+            // position of the innermost dimension of the layout or -1 if all dimensions are masked
+            template <class Layout>
+            constexpr int inner_dim() {
+                return Layout::unmasked_length == 0 ? -1 : (int)Layout::find(Layout::unmasked_length - 1);
+            }
+
+            /**
+             *  Calls `fun(indices, begin, end)` for all chunks of the rows along the innermost dimension of `Layout`
+             *  in parallel. `indices` are the indices of the row, the one of the innermost dimension is zero,
+             *  `[begin, end)` is the range of the chunk along the innermost dimension. Masked dimensions get the
+             *  index `length - 1`.
+             */
+            template <class Layout, class Info, class Fun>
+            void for_each_row(Info const &info, Fun const &fun) {
+                constexpr size_t ndims = Info::ndims;
+                constexpr int inner = inner_dim<Layout>();
+                auto lengths = info.lengths();
+                if (info.length() == 0)
+                    return;
+                int inner_length = inner < 0 ? 1 : lengths[inner];
+                int chunks = (inner_length + chunk_size - 1) / chunk_size;
+                int rows = 1;
+                for (int n = 0; n < (int)Layout::unmasked_length - 1; ++n)
+                    rows *= lengths[Layout::find(n)];
+                int tasks = rows * chunks;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+                for (int task = 0; task < tasks; ++task) {
+                    array<int, ndims> indices;
+                    int rest = task / chunks;
+                    for (int n = (int)Layout::unmasked_length - 2; n >= 0; --n) {
+                        auto dim = Layout::find(n);
+                        indices[dim] = rest % lengths[dim];
+                        rest /= lengths[dim];
+                    }
+                    for (size_t dim = 0; dim != ndims; ++dim)
+                        if (Layout::at(dim) < 0)
+                            indices[dim] = lengths[dim] - 1;
+                    if (inner >= 0)
+                        indices[inner] = 0;
+                    int begin = task % chunks * chunk_size;
+                    fun(indices, begin, std::min(begin + chunk_size, inner_length));
+                }
+            }
+
+            template <class Ptr, size_t N>
+            struct strided {
+                Ptr ptr;
+                array<int, N> strides;
+            };
+
+            template <class Ptr, class DataStore>
+            strided<Ptr, DataStore::ndims> make_strided(Ptr ptr, DataStore const &ds) {
+                strided<Ptr, DataStore::ndims> res = {ptr};
+                auto &&strides = ds.strides();
+                for (size_t i = 0; i != DataStore::ndims; ++i)
+                    res.strides[i] = strides[i];
+                return res;
+            }
+
+            template <class Fun, class... Ptrs>
+            void zip_row(Fun const &fun, int begin, int end, strided<Ptrs, 1>... args) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+                for (int i = begin; i < end; ++i)
+                    fun(args.ptr[i * args.strides[0]]...);
+            }
+
+            /**
+             *  Calls `fun(elements...)` for all elements of the arguments in parallel. The iteration follows the
+             *  layout of the first argument, the others are accessed with their own strides.
+             */
+            template <class Layout, class Info, class Fun, size_t N, class... Ptrs>
+            void zip(Info const &info, Fun const &fun, strided<Ptrs, N> const &...args) {
+                constexpr int inner = inner_dim<Layout>();
+                for_each_row<Layout>(info, [&](auto const &indices, int begin, int end) {
+                    auto row = [&](auto const &arg) {
+                        auto ptr = arg.ptr;
+                        for (size_t i = 0; i != N; ++i)
+                            ptr += indices[i] * arg.strides[i];
+                        return strided<decltype(ptr), 1>{ptr, {inner < 0 ? 0 : arg.strides[inner]}};
+                    };
+                    zip_row(fun, begin, end, row(args)...);
+                });
+            }
+
+            template <class DataStore, class... DataStores>
+            void check_lengths(char const *fun_name, DataStore const &ds, DataStores const &...others) {
+                for (bool ok : {(ds.lengths() == others.lengths())...})
+                    if (!ok)
+                        throw std::invalid_argument(std::string("storage::") + fun_name + ": lengths mismatch");
+            }
+        } // namespace algorithm_impl_
+
+        /**
+         *  Assigns `value` to all elements of the data store `ds`.
+         */
+        template <class DataStore, class T>
+        void fill(DataStore const &ds, T const &value) {
+            using layout_t = typename std::decay_t<decltype(*ds)>::layout_t;
+            algorithm_impl_::zip<layout_t>(
+                ds->info(), [&](auto &dst) { dst = value; }, algorithm_impl_::make_strided(ds->get_host_ptr(), *ds));
+        }
+
+        /**
+         *  Copies the elements of `src` to `dst`. The data stores may have different layouts and element types.
+         */
+        template <class Dst, class Src>
+        void copy(Dst const &dst, Src const &src) {
+            using layout_t = typename std::decay_t<decltype(*dst)>::layout_t;
+            algorithm_impl_::check_lengths("copy", *dst, *src);
+            algorithm_impl_::zip<layout_t>(
+                dst->info(),
+                [](auto &lhs, auto const &rhs) { lhs = rhs; },
+                algorithm_impl_::make_strided(dst->get_host_ptr(), *dst),
+                algorithm_impl_::make_strided(src->get_const_host_ptr(), *src));
+        }
+
+        /**
+         *  Computes `y = alpha * x + y` element wise.
+         */
+        template <class T, class X, class Y>
+        void axpy(T const &alpha, X const &x, Y const &y) {
+            using layout_t = typename std::decay_t<decltype(*y)>::layout_t;
+            algorithm_impl_::check_lengths("axpy", *y, *x);
+            algorithm_impl_::zip<layout_t>(
+                y->info(),
+                [&](auto &lhs, auto const &rhs) { lhs = alpha * rhs + lhs; },
+                algorithm_impl_::make_strided(y->get_host_ptr(), *y),
+                algorithm_impl_::make_strided(x->get_const_host_ptr(), *x));
+        }
+
+        /**
+         *  Returns true if `|actual - expected| <= atol + rtol * |expected|` holds for all elements.
+         *  NaNs are never considered equal.
+         */
+        template <class Actual, class Expected>
+        bool allclose(Actual const &actual, Expected const &expected, double rtol = 1e-5, double atol = 1e-8) {
+            using layout_t = typename std::decay_t<decltype(*actual)>::layout_t;
+            algorithm_impl_::check_lengths("allclose", *actual, *expected);
+            std::atomic<bool> res = true;
+            algorithm_impl_::zip<layout_t>(
+                actual->info(),
+                [&](auto const &lhs, auto const &rhs) {
+                    double a = lhs;
+                    double b = rhs;
+                    if (!(std::abs(a - b) <= atol + rtol * std::abs(b)))
+                        res.store(false, std::memory_order_relaxed);
+                },
+                algorithm_impl_::make_strided(actual->get_const_host_ptr(), *actual),
+                algorithm_impl_::make_strided(expected->get_const_host_ptr(), *expected));
+            return res;
+        }
+    } // namespace storage
+} // namespace gridtools
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <cassert>
 #include <tuple>
 #include <type_traits>
 
@@ -21,6 +22,7 @@
 #include "../common/tuple_util.hpp"
 #include "../meta.hpp"
 #include "../sid/unknown_kind.hpp"
+#include "algorithm.hpp"
 #include "data_store.hpp"
 #include "traits.hpp"
 
@@ -35,6 +37,8 @@ namespace gridtools {
                 struct halos {};
                 struct initializer {};
                 struct layout {};
+                struct innermost {};
+                struct traits {};
             } // namespace param
 
             template <class T>
@@ -47,40 +51,29 @@ namespace gridtools {
                 return obj;
             }
 
-            template <class Layout, class Info>
-            auto restore_indices(Info const &info, Layout, int src) {
-                auto l = info.lengths();
-                auto s = info.strides();
-                array<int, Info::ndims> res;
-                for (size_t i = 0; i < Info::ndims; ++i) {
-                    auto n = Layout::at(i);
-                    if (n == -1)
-                        res[i] = l[i] - 1;
-                    else if (n == 0)
-                        res[i] = src / s[i];
-                    else
-                        res[i] = src % s[Layout::find(n - 1)] / s[i];
-                }
-                return res;
+            // the innermost dimension of the layout has unit stride, the loop over it is vectorized
+            template <class T, class Layout, class Info, class Fun>
+            void for_each_row_ptr(T *dst, Layout, Info const &info, Fun const &fun) {
+                auto strides = info.strides();
+                assert(algorithm_impl_::inner_dim<Layout>() < 0 || strides[algorithm_impl_::inner_dim<Layout>()] == 1);
+                algorithm_impl_::for_each_row<Layout>(info, [&](auto const &indices, int begin, int end) {
+                    T *row = dst;
+                    for (size_t i = 0; i != Info::ndims; ++i)
+                        row += indices[i] * (int)strides[i];
+                    fun(row, indices, begin, end);
+                });
             }
 
             template <class Fun, class T, class Layout, class Info, size_t... Is>
             void initializer_impl(Fun const &fun, T *dst, Layout layout, Info const &info, std::index_sequence<Is...>) {
-                int length = info.length();
-                auto in_range = [&](auto const &indices) {
-                    for (auto ok : {(tuple_util::get<Is>(indices) < tuple_util::get<Is>(info.native_lengths()))...})
-                        if (!ok)
-                            return false;
-                    return true;
-                };
+                for_each_row_ptr(dst, layout, info, [&](T *row, auto const &indices, int begin, int end) {
+                    constexpr int inner = algorithm_impl_::inner_dim<Layout>();
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp simd
 #endif
-                for (int i = 0; i < length; ++i) {
-                    auto indices = restore_indices(info, layout, i);
-                    if (in_range(indices))
-                        dst[i] = fun(tuple_util::get<Is>(indices)...);
-                }
+                    for (int i = begin; i < end; ++i)
+                        row[i] = fun(((int)Is == inner ? i : indices[Is])...);
+                });
             }
 
             template <class Fun>
@@ -93,13 +86,14 @@ namespace gridtools {
 
             template <class T>
             auto wrap_value(T const &value) {
-                return [value = std::move(value)](auto *dst, auto, auto const &info) {
-                    int length = info.length();
+                return [value = std::move(value)](auto *dst, auto layout, auto const &info) {
+                    for_each_row_ptr(dst, layout, info, [&](auto *row, auto const &, int begin, int end) {
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp simd
 #endif
-                    for (int i = 0; i < length; ++i)
-                        dst[i] = value;
+                        for (int i = begin; i < end; ++i)
+                            row[i] = value;
+                    });
                 };
             }
 
@@ -165,6 +159,47 @@ namespace gridtools {
                 using type = layout_map<(Masks ? Args - correction(Args) : -1)...>;
             };
 
+            template <class, int>
+            struct move_innermost;
+
+            template <int... Args, int Dim>
+            struct move_innermost<layout_map<Args...>, Dim> {
+                using layout_t = layout_map<Args...>;
+                static_assert(Dim >= 0 && Dim < sizeof...(Args), "builder.innermost<...>() dimension is out of range");
+                static constexpr int arg = layout_t::at(Dim);
+                static_assert(arg >= 0, "builder.innermost<...>() dimension is masked in the default layout");
+
+                static constexpr int new_arg(int i, int cur) {
+                    return i == Dim ? int(layout_t::unmasked_length) - 1 : cur > arg ? cur - 1 : cur;
+                }
+
+                template <class>
+                struct impl;
+
+                template <size_t... Is>
+                struct impl<std::index_sequence<Is...>> {
+                    using type = layout_map<new_arg(Is, Args)...>;
+                };
+
+                using type = typename impl<std::make_index_sequence<sizeof...(Args)>>::type;
+            };
+
+            template <class Traits, size_t N, class Layout, class Innermost>
+            struct get_traits {
+                using type = custom_traits<Traits, Layout>;
+            };
+
+            template <class Traits, size_t N>
+            struct get_traits<Traits, N, void, void> {
+                using type = Traits;
+            };
+
+            template <class Traits, size_t N, class Innermost>
+            struct get_traits<Traits, N, void, Innermost> {
+                using layout_t = typename move_innermost<traits::layout_type<Traits, N>, Innermost::value>::type;
+                using type = custom_traits<Traits, layout_t>;
+            };
+
             template <class Traits, class Params>
             class builder_type {
                 Params m_params;
@@ -252,6 +287,7 @@ namespace gridtools {
                 template <int... Args>
                 auto layout() const {
                     static_assert(!has<param::layout>::value, "storage layout/selector is set twice");
+                    static_assert(!has<param::innermost>::value, "storage layout/innermost are both set");
                     check_dimensions_number<sizeof...(Args)>();
                     return add_type<param::layout, layout_map<Args...>>();
                 }
@@ -259,11 +295,24 @@ namespace gridtools {
                 template <bool... Args>
                 auto selector() const {
                     static_assert(!has<param::layout>::value, "storage layout/selector is set twice");
+                    static_assert(!has<param::innermost>::value, "storage selector/innermost are both set");
                     check_dimensions_number<sizeof...(Args)>();
                     using layout_t = typename apply_mask<traits::layout_type<Traits, sizeof...(Args)>, Args...>::type;
                     return add_type<param::layout, layout_t>();
                 }
 
+                /**
+                 *  Takes the default layout of the traits and makes the dimension `Dim` the innermost one (with unit
+                 *  stride). The order of the other dimensions is kept.
+                 *  E.g. `innermost<3>()` interleaves the colors of the icosahedral fields `(i, j, k, c)`.
+                 */
+                template <int Dim>
+                auto innermost() const {
+                    static_assert(!has<param::layout>::value, "storage layout/innermost are both set");
+                    static_assert(!has<param::innermost>::value, "storage innermost is set twice");
+                    return add_type<param::innermost, std::integral_constant<int, Dim>>();
+                }
+
                 auto name(std::string value) const {
                     static_assert(!has<param::name>::value, "storage name is set twice");
                     return add_value<param::name>(std::move(value));
@@ -300,18 +349,28 @@ namespace gridtools {
                     return add_value<param::initializer>(wrap_value(std::move(value)));
                 }
 
+                /**
+                 *  Sets the state of the stateful traits, like the file of storage::mmap_file.
+                 *  By default the traits are value initialized.
+                 */
+                auto traits(Traits value) const {
+                    static_assert(!has<param::traits>::value, "storage traits are set twice");
+                    return add_value<param::traits>(std::move(value));
+                }
+
                 auto build() const {
                     static_assert(has<param::type>::value, "storage type is not set");
                     static_assert(has<param::lengths>::value, "storage lengths are not set");
-                    using traits_t =
-                        meta::if_c<has<param::layout>::value, custom_traits<Traits, value_type<param::layout>>, Traits>;
                     auto &&lengths = value<param::lengths>();
                     auto &&name = value<param::name, std::string>();
                     constexpr auto n = tuple_util::size<decltype(lengths)>::value;
+                    using traits_t =
+                        typename get_traits<Traits, n, value_type<param::layout>, value_type<param::innermost>>::type;
                     auto &&halos = value<param::halos, array<int, n>>();
                     auto initializer = value<param::initializer, uninitialized>();
+                    traits_t storage_traits{value<param::traits, Traits>()};
                     return make_data_store<traits_t, typename value_type<param::type>::type, value_type<param::id>>(
-                        name, lengths, halos, initializer);
+                        name, lengths, halos, initializer, storage_traits);
                 }
 
                 auto operator()() const { return build(); }
@@ -0,0 +1,633 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../common/array.hpp"
+#include "../layout_transformation.hpp"
+#include "data_store.hpp"
+
+/**
+ *  @file
+ *  Binary checkpoint and restart of many data stores.
+ *
+ *  A checkpoint file is self describing: for every data store it holds the name, the element type, the lengths and
+ *  the data in a canonical dense layout, where the first dimension has unit stride and the masked dimensions have
+ *  length one. The data is split into chunks that are optionally compressed. The restart reads into data stores of
+ *  any layout, a dimension that is masked in the file is broadcast if it is not masked in the destination.
+ *
+ *  The writer takes a snapshot of a data store in the calling thread and compresses and writes the chunks in
+ *  background threads, so the computation can go on while the checkpoint is written. With MPI, every rank writes and
+ *  reads its own file.
+ *
+ *  File format (little endian of the host, all the integers are 64 bit unless noted):
+ *    magic (8 bytes) | chunks ... | directory | directory offset | directory size | magic (8 bytes)
+ *  where the directory holds the number of fields, followed for every field by the name length, the name, the
+ *  element size, the element kind, the number of dimensions, the lengths, the number of chunks and for every chunk
+ *  its offset, its stored size, its raw size and its codec.
+ */
+
+namespace gridtools {
+    namespace storage {
+        struct checkpoint_options {
+            // the chunks are compressed with a byte shuffling run length encoding, they are stored uncompressed if
+            // that does not reduce their size
+            bool compress = false;
+            // rounded down to a multiple of the element size, but at least one element
+            size_t chunk_bytes = 4 << 20;
+            // the number of background threads of the writer
+            int threads = 2;
+            // write blocks while more than that many bytes of snapshots are waiting to be written
+            size_t max_pending_bytes = size_t(1) << 30;
+        };
+
+        struct checkpoint_stats {
+            size_t raw_bytes = 0;
+            size_t file_bytes = 0;
+            double seconds = 0;
+
+            double gb_per_s() const { return seconds > 0 ? raw_bytes / seconds * 1e-9 : 0; }
+        };
+
+        namespace checkpoint_impl_ {
+            constexpr char magic[8] = {'G', 'T', 'C', 'K', 'P', 'T', '0', '1'};
+
+            enum codec : uint64_t { raw = 0, shuffled_rle = 1 };
+
+            enum kind : uint64_t { other = 0, floating_point = 1, signed_integer = 2, unsigned_integer = 3 };
+
+            template <class T>
+            constexpr kind kind_of() {
+                return std::is_floating_point_v<T> ? floating_point
+                       : std::is_integral_v<T>     ? (std::is_signed_v<T> ? signed_integer : unsigned_integer)
+                                                   : other;
+            }
+
+            [[noreturn]] inline void fail(std::string const &what, std::string const &path) {
+                throw std::runtime_error("checkpoint: " + what + " '" + path + "': " + std::strerror(errno));
+            }
+
+            inline void write_all(int fd, char const *src, size_t size, size_t offset, std::string const &path) {
+                while (size) {
+                    auto res = pwrite(fd, src, size, offset);
+                    if (res < 0) {
+                        if (errno == EINTR)
+                            continue;
+                        fail("cannot write", path);
+                    }
+                    src += res;
+                    size -= res;
+                    offset += res;
+                }
+            }
+
+            inline void read_all(int fd, char *dst, size_t size, size_t offset, std::string const &path) {
+                while (size) {
+                    auto res = pread(fd, dst, size, offset);
+                    if (res < 0 && errno == EINTR)
+                        continue;
+                    if (res <= 0)
+                        fail("cannot read", path);
+                    dst += res;
+                    size -= res;
+                    offset += res;
+                }
+            }
+
+            /**
+             *  The bytes of the elements are regrouped by significance, which puts the slowly varying exponent and
+             *  high order bytes of smooth fields next to each other. The result is run length encoded: a control byte
+             *  `c < 128` is followed by `c + 1` literal bytes, `c >= 128` by one byte that is repeated `c - 125`
+             *  times. If `size` is not a multiple of `elem_size`, the trailing bytes follow the shuffled ones as is.
+             */
+            inline std::vector<char> compress(char const *src, size_t size, size_t elem_size) {
+                size_t n = size / elem_size;
+                std::vector<char> shuffled(size);
+                for (size_t e = 0; e != n; ++e)
+                    for (size_t b = 0; b != elem_size; ++b)
+                        shuffled[b * n + e] = src[e * elem_size + b];
+                std::copy(src + n * elem_size, src + size, shuffled.begin() + n * elem_size);
+                std::vector<char> res;
+                res.reserve(size / 2);
+                size_t i = 0;
+                while (i < size) {
+                    size_t run = 1;
+                    while (i + run < size && run < 130 && shuffled[i + run] == shuffled[i])
+                        ++run;
+                    if (run >= 3) {
+                        res.push_back(char(run + 125));
+                        res.push_back(shuffled[i]);
+                        i += run;
+                        continue;
+                    }
+                    size_t begin = i;
+                    while (i < size && i - begin < 128) {
+                        if (i + 2 < size && shuffled[i] == shuffled[i + 1] && shuffled[i] == shuffled[i + 2])
+                            break;
+                        ++i;
+                    }
+                    res.push_back(char(i - begin - 1));
+                    res.insert(res.end(), shuffled.begin() + begin, shuffled.begin() + i);
+                }
+                return res;
+            }
+
+            inline void decompress(char const *src, size_t size, char *dst, size_t raw_size, size_t elem_size) {
+                std::vector<char> shuffled(raw_size);
+                size_t o = 0;
+                for (size_t i = 0; i < size;) {
+                    unsigned c = (unsigned char)src[i++];
+                    size_t count = c < 128 ? c + 1 : c - 125;
+                    if (o + count > raw_size || i + (c < 128 ? count : 1) > size)
+                        throw std::runtime_error("checkpoint: corrupted chunk");
+                    if (c < 128) {
+                        std::memcpy(shuffled.data() + o, src + i, count);
+                        i += count;
+                    } else {
+                        std::memset(shuffled.data() + o, src[i++], count);
+                    }
+                    o += count;
+                }
+                if (o != raw_size)
+                    throw std::runtime_error("checkpoint: corrupted chunk");
+                size_t n = raw_size / elem_size;
+                for (size_t e = 0; e != n; ++e)
+                    for (size_t b = 0; b != elem_size; ++b)
+                        dst[e * elem_size + b] = shuffled[b * n + e];
+                std::copy(shuffled.begin() + n * elem_size, shuffled.end(), dst + n * elem_size);
+            }
+
+            struct chunk_info {
+                uint64_t offset;
+                uint64_t stored_size;
+                uint64_t raw_size;
+                uint64_t codec;
+            };
+
+            struct field_info {
+                std::string name;
+                uint64_t elem_size;
+                uint64_t kind;
+                std::vector<uint64_t> lengths;
+                std::vector<chunk_info> chunks;
+            };
+
+            // the lengths of a data store with masked dimensions set to one
+            template <class DataStore>
+            auto unmasked_lengths(DataStore const &ds) {
+                auto res = ds.lengths();
+                auto &&strides = ds.strides();
+                for (size_t i = 0; i != res.size(); ++i)
+                    if (strides[i] == 0)
+                        res[i] = 1;
+                return res;
+            }
+
+            template <class Lengths>
+            Lengths dense_strides(Lengths const &lengths) {
+                Lengths res;
+                size_t stride = 1;
+                for (size_t i = 0; i != lengths.size(); ++i) {
+                    res[i] = stride;
+                    stride *= lengths[i];
+                }
+                return res;
+            }
+
+            class serializer {
+                std::vector<char> m_data;
+
+              public:
+                void put(uint64_t val) {
+                    auto src = reinterpret_cast<char const *>(&val);
+                    m_data.insert(m_data.end(), src, src + sizeof(val));
+                }
+                void put(std::string const &val) {
+                    put(uint64_t(val.size()));
+                    m_data.insert(m_data.end(), val.begin(), val.end());
+                }
+                std::vector<char> const &data() const { return m_data; }
+            };
+
+            class deserializer {
+                char const *m_cur;
+                char const *m_end;
+
+                void check(size_t size) const {
+                    if (size_t(m_end - m_cur) < size)
+                        throw std::runtime_error("checkpoint: corrupted directory");
+                }
+
+              public:
+                deserializer(std::vector<char> const &data) : m_cur(data.data()), m_end(data.data() + data.size()) {}
+
+                uint64_t get() {
+                    uint64_t res;
+                    check(sizeof(res));
+                    std::memcpy(&res, m_cur, sizeof(res));
+                    m_cur += sizeof(res);
+                    return res;
+                }
+                std::string get_string() {
+                    size_t size = get();
+                    check(size);
+                    std::string res(m_cur, size);
+                    m_cur += size;
+                    return res;
+                }
+            };
+        } // namespace checkpoint_impl_
+
+        /**
+         *  Writes data stores to a checkpoint file. `write` returns as soon as the data store is copied, the file is
+         *  complete when `close` returns.
+         */
+        class checkpoint_writer {
+            using clock_t = std::chrono::steady_clock;
+
+            struct snapshot {
+                size_t field;
+                size_t elem_size;
+                // `chunk_bytes` of the options rounded down to whole elements
+                size_t chunk_bytes;
+                std::vector<char> data;
+            };
+
+            struct job {
+                std::shared_ptr<snapshot> src;
+                size_t chunk;
+            };
+
+            std::string m_path;
+            checkpoint_options m_options;
+            int m_fd;
+            std::vector<checkpoint_impl_::field_info> m_fields;
+            std::atomic<size_t> m_offset{sizeof(checkpoint_impl_::magic)};
+            size_t m_raw_bytes = 0;
+            clock_t::time_point m_start;
+            bool m_started = false;
+            bool m_closed = false;
+
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            std::deque<job> m_jobs;
+            size_t m_pending_bytes = 0;
+            bool m_done = false;
+            std::exception_ptr m_error;
+            std::vector<std::thread> m_threads;
+
+            void work() {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                while (true) {
+                    m_cv.wait(lock, [&] { return m_done || !m_jobs.empty(); });
+                    if (m_jobs.empty())
+                        return;
+                    job j = std::move(m_jobs.front());
+                    m_jobs.pop_front();
+                    lock.unlock();
+                    size_t begin = j.chunk * j.src->chunk_bytes;
+                    size_t size = std::min(j.src->chunk_bytes, j.src->data.size() - begin);
+                    try {
+                        write_chunk(*j.src, j.chunk, j.src->data.data() + begin, size);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> guard(m_mutex);
+                        if (!m_error)
+                            m_error = std::current_exception();
+                    }
+                    j.src.reset();
+                    lock.lock();
+                    m_pending_bytes -= size;
+                    m_cv.notify_all();
+                }
+            }
+
+            void write_chunk(snapshot const &src, size_t chunk, char const *data, size_t size) {
+                using namespace checkpoint_impl_;
+                std::vector<char> compressed;
+                chunk_info info = {0, size, size, raw};
+                if (m_options.compress) {
+                    compressed = compress(data, size, src.elem_size);
+                    if (compressed.size() < size) {
+                        info.stored_size = compressed.size();
+                        info.codec = shuffled_rle;
+                        data = compressed.data();
+                    }
+                }
+                info.offset = m_offset.fetch_add(info.stored_size);
+                write_all(m_fd, data, info.stored_size, info.offset, m_path);
+                std::lock_guard<std::mutex> guard(m_mutex);
+                m_fields[src.field].chunks[chunk] = info;
+            }
+
+            void stop() {
+                {
+                    std::lock_guard<std::mutex> guard(m_mutex);
+                    m_done = true;
+                }
+                m_cv.notify_all();
+                for (auto &thread : m_threads)
+                    thread.join();
+                m_threads.clear();
+            }
+
+          public:
+            checkpoint_writer(std::string path, checkpoint_options options = {})
+                : m_path(std::move(path)), m_options(options) {
+                if (m_options.chunk_bytes == 0 || m_options.threads <= 0)
+                    throw std::invalid_argument("checkpoint: invalid options");
+                m_fd = open(m_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+                if (m_fd < 0)
+                    checkpoint_impl_::fail("cannot create", m_path);
+                checkpoint_impl_::write_all(
+                    m_fd, checkpoint_impl_::magic, sizeof(checkpoint_impl_::magic), 0, m_path);
+                for (int i = 0; i != m_options.threads; ++i)
+                    m_threads.emplace_back([this] { work(); });
+            }
+
+            checkpoint_writer(checkpoint_writer const &) = delete;
+            checkpoint_writer &operator=(checkpoint_writer const &) = delete;
+
+            ~checkpoint_writer() {
+                if (m_closed)
+                    return;
+                stop();
+                ::close(m_fd);
+            }
+
+            /**
+             *  Takes a snapshot of the data store and queues it for writing. The data store is identified by its name.
+             */
+            template <class DataStorePtr>
+            void write(DataStorePtr const &ds) {
+                using namespace checkpoint_impl_;
+                static_assert(is_data_store_ptr<DataStorePtr>::value, "checkpoint_writer writes data stores");
+                using data_t = std::remove_const_t<typename DataStorePtr::element_type::data_t>;
+                static_assert(std::is_trivially_copyable_v<data_t>, "checkpoint elements must be trivially copyable");
+                if (m_closed)
+                    throw std::logic_error("checkpoint: write after close");
+                if (!m_started) {
+                    m_start = clock_t::now();
+                    m_started = true;
+                }
+                for (auto const &field : m_fields)
+                    if (field.name == ds->name())
+                        throw std::invalid_argument("checkpoint: duplicate field '" + ds->name() + "'");
+
+                auto lengths = unmasked_lengths(*ds);
+                size_t count = 1;
+                for (auto length : lengths)
+                    count *= length;
+                size_t chunk_bytes = std::max(m_options.chunk_bytes / sizeof(data_t), size_t(1)) * sizeof(data_t);
+                auto src = std::make_shared<snapshot>(snapshot{m_fields.size(), sizeof(data_t), chunk_bytes, {}});
+                src->data.resize(count * sizeof(data_t));
+                if (count)
+                    transform_layout(reinterpret_cast<data_t *>(src->data.data()),
+                        ds->get_const_host_ptr(),
+                        lengths,
+                        dense_strides(lengths),
+                        ds->strides());
+                size_t num_chunks = (src->data.size() + chunk_bytes - 1) / chunk_bytes;
+                m_raw_bytes += src->data.size();
+
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_fields.push_back({ds->name(),
+                    sizeof(data_t),
+                    kind_of<data_t>(),
+                    std::vector<uint64_t>(lengths.begin(), lengths.end()),
+                    std::vector<chunk_info>(num_chunks)});
+                m_cv.wait(lock, [&] { return m_pending_bytes == 0 || m_pending_bytes < m_options.max_pending_bytes; });
+                m_pending_bytes += src->data.size();
+                for (size_t chunk = 0; chunk != num_chunks; ++chunk)
+                    m_jobs.push_back({src, chunk});
+                m_cv.notify_all();
+            }
+
+            /**
+             *  Waits for the pending writes and completes the file.
+             */
+            checkpoint_stats close() {
+                using namespace checkpoint_impl_;
+                if (m_closed)
+                    throw std::logic_error("checkpoint: closed twice");
+                stop();
+                m_closed = true;
+                if (m_error) {
+                    ::close(m_fd);
+                    std::rethrow_exception(m_error);
+                }
+                serializer dir;
+                dir.put(m_fields.size());
+                for (auto const &field : m_fields) {
+                    dir.put(field.name);
+                    dir.put(field.elem_size);
+                    dir.put(field.kind);
+                    dir.put(field.lengths.size());
+                    for (auto length : field.lengths)
+                        dir.put(length);
+                    dir.put(field.chunks.size());
+                    for (auto const &chunk : field.chunks) {
+                        dir.put(chunk.offset);
+                        dir.put(chunk.stored_size);
+                        dir.put(chunk.raw_size);
+                        dir.put(chunk.codec);
+                    }
+                }
+                size_t dir_offset = m_offset;
+                size_t dir_size = dir.data().size();
+                dir.put(dir_offset);
+                dir.put(dir_size);
+                std::vector<char> tail = dir.data();
+                tail.insert(tail.end(), std::begin(magic), std::end(magic));
+                write_all(m_fd, tail.data(), tail.size(), dir_offset, m_path);
+                if (::close(m_fd) != 0)
+                    fail("cannot close", m_path);
+                checkpoint_stats res;
+                res.raw_bytes = m_raw_bytes;
+                res.file_bytes = dir_offset + tail.size();
+                if (m_started)
+                    res.seconds = std::chrono::duration<double>(clock_t::now() - m_start).count();
+                return res;
+            }
+        };
+
+        /**
+         *  Reads data stores from a checkpoint file.
+         */
+        class checkpoint_reader {
+            std::string m_path;
+            int m_fd;
+            std::map<std::string, checkpoint_impl_::field_info> m_fields;
+            checkpoint_stats m_stats;
+
+          public:
+            explicit checkpoint_reader(std::string path) : m_path(std::move(path)) {
+                using namespace checkpoint_impl_;
+                m_fd = open(m_path.c_str(), O_RDONLY);
+                if (m_fd < 0)
+                    fail("cannot open", m_path);
+                try {
+                    off_t size = lseek(m_fd, 0, SEEK_END);
+                    char footer[2 * sizeof(uint64_t) + sizeof(magic)];
+                    if (size < off_t(sizeof(magic) + sizeof(footer)))
+                        throw std::runtime_error("checkpoint: '" + m_path + "' is not a checkpoint");
+                    read_all(m_fd, footer, sizeof(footer), size - sizeof(footer), m_path);
+                    if (std::memcmp(footer + 2 * sizeof(uint64_t), magic, sizeof(magic)) != 0)
+                        throw std::runtime_error("checkpoint: '" + m_path + "' is not a checkpoint");
+                    uint64_t dir_offset, dir_size;
+                    std::memcpy(&dir_offset, footer, sizeof(uint64_t));
+                    std::memcpy(&dir_size, footer + sizeof(uint64_t), sizeof(uint64_t));
+                    if (dir_offset + dir_size + sizeof(footer) != uint64_t(size))
+                        throw std::runtime_error("checkpoint: corrupted directory");
+                    std::vector<char> data(dir_size);
+                    read_all(m_fd, data.data(), dir_size, dir_offset, m_path);
+                    deserializer dir(data);
+                    for (size_t n = dir.get(); n; --n) {
+                        field_info field;
+                        field.name = dir.get_string();
+                        field.elem_size = dir.get();
+                        field.kind = dir.get();
+                        field.lengths.resize(dir.get());
+                        for (auto &length : field.lengths)
+                            length = dir.get();
+                        field.chunks.resize(dir.get());
+                        for (auto &chunk : field.chunks)
+                            chunk = {dir.get(), dir.get(), dir.get(), dir.get()};
+                        std::string name = field.name;
+                        m_fields.emplace(std::move(name), std::move(field));
+                    }
+                } catch (...) {
+                    ::close(m_fd);
+                    throw;
+                }
+            }
+
+            checkpoint_reader(checkpoint_reader const &) = delete;
+            checkpoint_reader &operator=(checkpoint_reader const &) = delete;
+
+            ~checkpoint_reader() { ::close(m_fd); }
+
+            std::vector<std::string> names() const {
+                std::vector<std::string> res;
+                for (auto const &item : m_fields)
+                    res.push_back(item.first);
+                return res;
+            }
+
+            bool contains(std::string const &name) const { return m_fields.count(name); }
+
+            /**
+             *  Reads the field with the given name into the data store. The lengths must match, except for the
+             *  dimensions that are masked in the file: their only value is broadcast.
+             */
+            template <class DataStorePtr>
+            void read(std::string const &name, DataStorePtr const &ds) {
+                using namespace checkpoint_impl_;
+                static_assert(is_data_store_ptr<DataStorePtr>::value, "checkpoint_reader reads data stores");
+                using data_t = typename DataStorePtr::element_type::data_t;
+                static_assert(!std::is_const_v<data_t>, "checkpoint_reader reads into mutable data stores");
+                auto start = std::chrono::steady_clock::now();
+
+                auto found = m_fields.find(name);
+                if (found == m_fields.end())
+                    throw std::invalid_argument("checkpoint: no field '" + name + "' in '" + m_path + "'");
+                field_info const &field = found->second;
+                if (field.elem_size != sizeof(data_t) || field.kind != kind_of<data_t>())
+                    throw std::invalid_argument("checkpoint: type mismatch for field '" + name + "'");
+                auto lengths = unmasked_lengths(*ds);
+                if (field.lengths.size() != lengths.size())
+                    throw std::invalid_argument("checkpoint: rank mismatch for field '" + name + "'");
+
+                std::vector<uint64_t> file_lengths = field.lengths;
+                auto src_strides = lengths;
+                size_t count = 1;
+                for (size_t i = 0; i != lengths.size(); ++i) {
+                    src_strides[i] = count;
+                    count *= file_lengths[i];
+                    if (file_lengths[i] == 1)
+                        src_strides[i] = 0;
+                    else if (file_lengths[i] != lengths[i])
+                        throw std::invalid_argument("checkpoint: length mismatch for field '" + name + "'");
+                }
+
+                std::vector<char> data(count * sizeof(data_t));
+                size_t raw_offset = 0;
+                std::vector<size_t> raw_offsets;
+                for (auto const &chunk : field.chunks) {
+                    raw_offsets.push_back(raw_offset);
+                    raw_offset += chunk.raw_size;
+                }
+                if (raw_offset != data.size())
+                    throw std::runtime_error("checkpoint: corrupted field '" + name + "'");
+
+                std::exception_ptr error;
+                int num_chunks = field.chunks.size();
+#pragma omp parallel for schedule(dynamic)
+                for (int i = 0; i < num_chunks; ++i) {
+                    try {
+                        auto const &chunk = field.chunks[i];
+                        char *dst = data.data() + raw_offsets[i];
+                        if (chunk.codec == raw) {
+                            read_all(m_fd, dst, chunk.raw_size, chunk.offset, m_path);
+                        } else {
+                            std::vector<char> stored(chunk.stored_size);
+                            read_all(m_fd, stored.data(), chunk.stored_size, chunk.offset, m_path);
+                            decompress(stored.data(), stored.size(), dst, chunk.raw_size, sizeof(data_t));
+                        }
+                    } catch (...) {
+#pragma omp critical
+                        error = std::current_exception();
+                    }
+                }
+                if (error)
+                    std::rethrow_exception(error);
+
+                if (count)
+                    transform_layout(ds->get_host_ptr(),
+                        reinterpret_cast<data_t const *>(data.data()),
+                        lengths,
+                        ds->strides(),
+                        src_strides);
+
+                m_stats.raw_bytes += data.size();
+                for (auto const &chunk : field.chunks)
+                    m_stats.file_bytes += chunk.stored_size;
+                m_stats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+
+            template <class DataStorePtr>
+            void read(DataStorePtr const &ds) {
+                read(ds->name(), ds);
+            }
+
+            // the accumulated amount of data and time of the reads
+            checkpoint_stats const &stats() const { return m_stats; }
+        };
+    } // namespace storage
+} // namespace gridtools
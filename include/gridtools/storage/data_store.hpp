@@ -11,6 +11,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -20,6 +21,7 @@
 #include "../common/defs.hpp"
 #include "../common/integral_constant.hpp"
 #include "../common/layout_map.hpp"
+#include "../common/memory_accounting.hpp"
 #include "data_view.hpp"
 #include "info.hpp"
 #include "traits.hpp"
@@ -44,6 +46,18 @@ namespace gridtools {
                 Info m_info;
                 traits::target_ptr_type<Traits, mutable_data_t> m_target_ptr_holder;
                 mutable_data_t *m_target_ptr;
+                memory_accounting::record m_record;
+
+                // the elements of the unmasked dimensions are requested, the rest is padding and alignment
+                static std::size_t requested_length(Info const &info) {
+                    std::size_t res = 1;
+                    auto &&lengths = info.lengths();
+                    auto &&strides = info.strides();
+                    for (size_t i = 0; i != Info::ndims; ++i)
+                        if (strides[i])
+                            res *= lengths[i];
+                    return res;
+                }
 
               public:
                 using layout_t = traits::layout_type<Traits, Info::ndims>;
@@ -61,9 +75,13 @@ namespace gridtools {
 
               protected:
                 template <class Halos>
-                base(std::string name, Info info, Halos const &halos)
+                base(std::string name, Info info, Halos const &halos, Traits const &storage_traits)
                     : m_name(std::move(name)), m_info(std::move(info)),
-                      m_target_ptr_holder(traits::allocate<Traits, mutable_data_t>(m_info.length() + alignment_t())) {
+                      m_target_ptr_holder(
+                          traits::allocate<Traits, mutable_data_t>(m_info.length() + alignment_t(), storage_traits)),
+                      m_record(memory_accounting::category::storage,
+                          (m_info.length() + alignment_t()) * sizeof(T),
+                          (m_info.length() + alignment_t() - requested_length(m_info)) * sizeof(T)) {
                     auto offset_to_align = m_info.index_from_tuple(halos);
                     auto byte_offset = offset_to_align * sizeof(T);
                     auto address_to_align = reinterpret_cast<std::uintptr_t>(m_target_ptr_holder.get()) + byte_offset;
@@ -104,13 +122,22 @@ namespace gridtools {
 
               public:
                 template <class Halos>
-                data_store(std::string name, Info info, Halos const &halos, uninitialized const &)
-                    : data_store::base(std::move(name), std::move(info), halos), m_state(synced),
+                data_store(std::string name,
+                    Info info,
+                    Halos const &halos,
+                    uninitialized const &,
+                    Traits const &storage_traits)
+                    : data_store::base(std::move(name), std::move(info), halos, storage_traits), m_state(synced),
                       m_host_ptr(std::make_unique<T[]>(this->info().length())) {}
 
                 template <class Initializer, class Halos>
-                data_store(std::string name, Info info, Halos const &halos, Initializer const &initializer)
-                    : data_store::base(std::move(name), std::move(info), halos), m_state(invalid_target),
+                data_store(std::string name,
+                    Info info,
+                    Halos const &halos,
+                    Initializer const &initializer,
+                    Traits const &storage_traits)
+                    : data_store::base(std::move(name), std::move(info), halos, storage_traits),
+                      m_state(invalid_target),
                       m_host_ptr(std::make_unique<T[]>(this->info().length())) {
                     initializer(m_host_ptr.get(), typename data_store::layout_t(), this->info());
                 }
@@ -150,12 +177,20 @@ namespace gridtools {
             class data_store<Traits, T, Info, Kind, false, true> : public base<Traits, T, Info, Kind> {
               public:
                 template <class Halos>
-                data_store(std::string name, Info info, Halos const &halos, uninitialized const &)
-                    : data_store::base(std::move(name), std::move(info), halos) {}
+                data_store(std::string name,
+                    Info info,
+                    Halos const &halos,
+                    uninitialized const &,
+                    Traits const &storage_traits)
+                    : data_store::base(std::move(name), std::move(info), halos, storage_traits) {}
 
                 template <class Initializer, class Halos>
-                data_store(std::string name, Info info, Halos const &halos, Initializer const &initializer)
-                    : data_store::base(std::move(name), std::move(info), halos) {
+                data_store(std::string name,
+                    Info info,
+                    Halos const &halos,
+                    Initializer const &initializer,
+                    Traits const &storage_traits)
+                    : data_store::base(std::move(name), std::move(info), halos, storage_traits) {
                     initializer(this->raw_target_ptr(), typename data_store::layout_t(), this->info());
                 }
 
@@ -179,11 +214,15 @@ namespace gridtools {
 
               public:
                 template <class Halos>
-                data_store(std::string, Info, Halos const &, uninitialized const &) = delete;
+                data_store(std::string, Info, Halos const &, uninitialized const &, Traits const &) = delete;
 
                 template <class Initializer, class Halos>
-                data_store(std::string name, Info info, Halos const &halos, Initializer const &initializer)
-                    : data_store::base(std::move(name), std::move(info), halos),
+                data_store(std::string name,
+                    Info info,
+                    Halos const &halos,
+                    Initializer const &initializer,
+                    Traits const &storage_traits)
+                    : data_store::base(std::move(name), std::move(info), halos, storage_traits),
                       m_host_ptr(std::make_unique<T[]>(this->info().length())) {
                     initializer(m_host_ptr.get(), typename data_store::layout_t(), this->info());
                     traits::update_target<Traits>(this->raw_target_ptr(), m_host_ptr.get(), this->info().length());
@@ -203,12 +242,29 @@ namespace gridtools {
             template <class Traits, class T, class Info, class Kind>
             class data_store<Traits, T const, Info, Kind, true, true> : public base<Traits, T const, Info, Kind> {
               public:
-                template <class Halos>
-                data_store(std::string, Info, Halos const &, uninitialized const &) = delete;
+                // the contents of the memory are meaningful without initialization only for some traits
+                template <class Halos,
+                    class Tr = Traits,
+                    std::enable_if_t<traits::has_persistent_contents<Tr>, int> = 0>
+                data_store(std::string name,
+                    Info info,
+                    Halos const &halos,
+                    uninitialized const &,
+                    Traits const &storage_traits)
+                    : base<Traits, T const, Info, Kind>(std::move(name), std::move(info), halos, storage_traits) {}
+
+                template <class Halos,
+                    class Tr = Traits,
+                    std::enable_if_t<!traits::has_persistent_contents<Tr>, int> = 0>
+                data_store(std::string, Info, Halos const &, uninitialized const &, Traits const &) = delete;
 
                 template <class Initializer, class Halos>
-                data_store(std::string name, Info info, Halos const &halos, Initializer const &initializer)
-                    : base<Traits, T const, Info, Kind>(std::move(name), std::move(info), halos) {
+                data_store(std::string name,
+                    Info info,
+                    Halos const &halos,
+                    Initializer const &initializer,
+                    Traits const &storage_traits)
+                    : base<Traits, T const, Info, Kind>(std::move(name), std::move(info), halos, storage_traits) {
                     initializer(this->raw_target_ptr(), typename data_store::layout_t(), this->info());
                 }
                 T const *get_target_ptr() const { return this->raw_target_ptr(); }
@@ -234,17 +290,27 @@ namespace gridtools {
             struct is_data_store_ptr<std::shared_ptr<data_store<Traits, T, Info, Id>>> : std::true_type {};
 
             template <class Traits, class T, class Kind, class Info, class Halos, class Initializer>
-            auto make_data_store_helper(
-                std::string name, Info info, Halos const &halos, Initializer const &initializer) {
+            auto make_data_store_helper(std::string name,
+                Info info,
+                Halos const &halos,
+                Initializer const &initializer,
+                Traits const &storage_traits) {
+                if (traits::is_read_only(storage_traits) &&
+                    (!std::is_const_v<T> || !std::is_same_v<Initializer, uninitialized>))
+                    throw std::invalid_argument("storage '" + name +
+                                                "': read-only memory needs a const element type and no initializer");
                 return std::make_shared<data_store<Traits, T, Info, Kind>>(
-                    std::move(name), std::move(info), halos, initializer);
+                    std::move(name), std::move(info), halos, initializer, storage_traits);
             }
 
             template <class Traits, class T, class Id, class Lengths, class Halos, class Initializer>
-            auto make_data_store(
-                std::string name, Lengths const &lengths, Halos const &halos, Initializer const &initializer) {
+            auto make_data_store(std::string name,
+                Lengths const &lengths,
+                Halos const &halos,
+                Initializer const &initializer,
+                Traits const &storage_traits = {}) {
                 return make_data_store_helper<Traits, T, traits::strides_kind<Traits, T, Lengths, Id>>(
-                    std::move(name), traits::make_info<Traits, T>(lengths), halos, initializer);
+                    std::move(name), traits::make_info<Traits, T>(lengths), halos, initializer, storage_traits);
             }
 
             template <class DataStore>
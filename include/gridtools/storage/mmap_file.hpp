@@ -0,0 +1,165 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../common/integral_constant.hpp"
+#include "cpu_ifirst.hpp"
+
+/**
+ *  @file
+ *  Storage traits that map a file into memory instead of allocating anonymous memory.
+ *
+ *  The layout and the alignment are the ones of storage::cpu_ifirst. The file holds the whole allocation of the data
+ *  store including the padding, so a data store that is built with the same type, dimensions, halos and layout maps
+ *  the same elements to the same positions of the file. The file can be produced by a previous run, or shared by
+ *  several processes of a node through the page cache. A data store that is built without initializer keeps the
+ *  contents of the file, this is also allowed for read-only element types.
+ *
+ *  Example:
+ *  \code
+ *  auto topography = storage::builder<storage::mmap_file>
+ *      .traits({"topography.bin", storage::mmap_mode::read_only, true})
+ *      .type<double const>()
+ *      .dimensions(nx, ny, 1)
+ *      .build();
+ *  \endcode
+ */
+
+namespace gridtools {
+    namespace storage {
+        enum class mmap_mode {
+            read_only,     // the file must exist and be large enough, the element type must be const and
+                           // the data store must be built without initializer
+            read_write,    // the file is created or extended if needed, the modifications are written to the file
+            copy_on_write, // the file must exist and be large enough, the modifications stay private to the process
+        };
+
+        enum class mmap_advice { normal, sequential, random, will_need };
+
+        namespace mmap_file_impl_ {
+            [[noreturn]] inline void fail(std::string const &what, std::string const &path) {
+                throw std::runtime_error("mmap_file: " + what + " '" + path + "': " + std::strerror(errno));
+            }
+
+            inline int to_posix(mmap_advice advice) {
+                switch (advice) {
+                case mmap_advice::sequential:
+                    return MADV_SEQUENTIAL;
+                case mmap_advice::random:
+                    return MADV_RANDOM;
+                case mmap_advice::will_need:
+                    return MADV_WILLNEED;
+                default:
+                    return MADV_NORMAL;
+                }
+            }
+
+            struct unmapper {
+                size_t m_bytes = 0;
+
+                template <class T>
+                void operator()(T *p) const {
+                    munmap(const_cast<std::remove_cv_t<T> *>(p), m_bytes);
+                }
+            };
+
+            inline void *map(std::string const &path, mmap_mode mode, bool populate, mmap_advice advice, size_t bytes) {
+                if (path.empty())
+                    throw std::invalid_argument("mmap_file: no file is given");
+                bool writable = mode == mmap_mode::read_write;
+                int fd = open(path.c_str(), writable ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+                if (fd < 0)
+                    fail("cannot open", path);
+                struct stat st;
+                if (fstat(fd, &st) != 0) {
+                    close(fd);
+                    fail("cannot stat", path);
+                }
+                if (size_t(st.st_size) < bytes) {
+                    if (!writable) {
+                        close(fd);
+                        throw std::runtime_error("mmap_file: '" + path + "' has " + std::to_string(st.st_size) +
+                                                 " bytes, " + std::to_string(bytes) + " are needed");
+                    }
+                    if (ftruncate(fd, bytes) != 0) {
+                        close(fd);
+                        fail("cannot resize", path);
+                    }
+                }
+                int prot = mode == mmap_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+                int flags = mode == mmap_mode::copy_on_write ? MAP_PRIVATE : MAP_SHARED;
+#ifdef MAP_POPULATE
+                if (populate)
+                    flags |= MAP_POPULATE;
+#endif
+                void *res = mmap(nullptr, bytes, prot, flags, fd, 0);
+                close(fd);
+                if (res == MAP_FAILED)
+                    fail("cannot map", path);
+                if (advice != mmap_advice::normal)
+                    madvise(res, bytes, to_posix(advice));
+                return res;
+            }
+        } // namespace mmap_file_impl_
+
+        /**
+         *  File backed storage traits. The state is given to the builder with `.traits(...)`.
+         *
+         *  `populate` prefaults the whole mapping at construction (MAP_POPULATE where available), `advice` is passed to
+         *  madvise as a read-ahead hint for the access pattern.
+         *
+         *  The `read_only` mode maps the file without write permission. Building a data store with a non-const element
+         *  type, an initializer or a value in this mode throws std::invalid_argument instead of faulting later.
+         */
+        struct mmap_file {
+            std::string path;
+            mmap_mode mode = mmap_mode::read_write;
+            bool populate = false;
+            mmap_advice advice = mmap_advice::normal;
+
+            friend std::true_type storage_is_host_referenceable(mmap_file) { return {}; }
+
+            friend std::true_type storage_has_persistent_contents(mmap_file) { return {}; }
+
+            friend bool storage_is_read_only(mmap_file const &traits) { return traits.mode == mmap_mode::read_only; }
+
+            template <size_t Dims>
+            friend typename cpu_ifirst_impl_::make_layout<Dims>::type storage_layout(
+                mmap_file, std::integral_constant<size_t, Dims>) {
+                return {};
+            }
+
+            friend integral_constant<size_t, 64> storage_alignment(mmap_file) { return {}; }
+
+            template <class LazyType, class T = typename LazyType::type>
+            friend auto storage_allocate(mmap_file const &traits, LazyType, size_t size) {
+                using ptr_t = std::unique_ptr<T[], mmap_file_impl_::unmapper>;
+                size_t bytes = size * sizeof(T);
+                if (bytes == 0)
+                    return ptr_t(nullptr, {});
+                return ptr_t(static_cast<T *>(mmap_file_impl_::map(
+                                 traits.path, traits.mode, traits.populate, traits.advice, bytes)),
+                    {bytes});
+            }
+        };
+    } // namespace storage
+} // namespace gridtools
@@ -25,6 +25,34 @@ namespace gridtools {
             constexpr bool is_host_referenceable =
                 decltype(storage_is_host_referenceable(std::declval<Traits>()))::value;
 
+            template <class Traits, class = void>
+            struct has_persistent_contents_helper : std::false_type {};
+
+            template <class Traits>
+            struct has_persistent_contents_helper<Traits,
+                std::void_t<decltype(storage_has_persistent_contents(std::declval<Traits>()))>>
+                : decltype(storage_has_persistent_contents(std::declval<Traits>())) {};
+
+            // whether the allocated memory holds meaningful data before any initialization, like a mapped file
+            template <class Traits>
+            constexpr bool has_persistent_contents = has_persistent_contents_helper<Traits>::value;
+
+            template <class Traits, class = void>
+            struct has_read_only_state : std::false_type {};
+
+            template <class Traits>
+            struct has_read_only_state<Traits, std::void_t<decltype(storage_is_read_only(std::declval<Traits>()))>>
+                : std::true_type {};
+
+            // whether the allocated memory must not be written, like a read-only file mapping; known at run time only
+            template <class Traits>
+            bool is_read_only(Traits const &traits) {
+                if constexpr (has_read_only_state<Traits>::value)
+                    return storage_is_read_only(traits);
+                else
+                    return false;
+            }
+
             template <class Traits>
             constexpr size_t byte_alignment = decltype(storage_alignment(std::declval<Traits>()))::value;
 
@@ -80,8 +108,8 @@ namespace gridtools {
             }
 
             template <class Traits, class T>
-            auto allocate(size_t size) {
-                return storage_allocate(Traits(), meta::lazy::id<T>(), size);
+            auto allocate(size_t size, Traits const &traits = {}) {
+                return storage_allocate(traits, meta::lazy::id<T>(), size);
             }
 
             template <class Traits, class T>
@@ -13,6 +13,7 @@
 
 #include <gridtools/storage/builder.hpp>
 #include <type_traits>
+#include <vector>
 
 namespace gridtools {
 
@@ -123,6 +124,32 @@ namespace gridtools {
             return storage::builder<StorageTraits>.dimensions(nvertices(), max_v2e_neighbors_t()).template type<int const>().initializer(v2e_initializer()).unknown_id().build();
         }
 
+        /// CSR representation of the v2e table: `v2e_csr_offsets()[v]` is the position of the first neighbor of
+        /// vertex `v` in `v2e_csr_indices()`, there is no padding
+        auto v2e_csr_offsets() const {
+            std::vector<int> offsets(nvertices() + 1, 0);
+            auto init = v2e_initializer();
+            for (int v = 0; v < nvertices(); ++v) {
+                int n = 0;
+                while (n < max_v2e_neighbors_t::value && init(v, n) != -1)
+                    ++n;
+                offsets[v + 1] = offsets[v] + n;
+            }
+            auto init_offsets = [offsets = std::move(offsets)](int v) { return offsets[v]; };
+            return storage::builder<StorageTraits>.dimensions(nvertices() + 1).template type<int const>().initializer(init_offsets).unknown_id().build();
+        }
+
+        auto v2e_csr_indices() const {
+            std::vector<int> indices;
+            auto init = v2e_initializer();
+            for (int v = 0; v < nvertices(); ++v)
+                for (int n = 0; n < max_v2e_neighbors_t::value && init(v, n) != -1; ++n)
+                    indices.push_back(init(v, n));
+            int size = indices.size();
+            auto init_indices = [indices = std::move(indices)](int i) { return indices[i]; };
+            return storage::builder<StorageTraits>.dimensions(size).template type<int const>().initializer(init_indices).unknown_id().build();
+        }
+
         auto e2v_table() const {
             return storage::builder<StorageTraits>.dimensions(nedges(), max_e2v_neighbors_t()).template type<int const>().initializer(e2v_initializer()).unknown_id().build();
         }
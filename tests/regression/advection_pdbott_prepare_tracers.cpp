@@ -57,4 +57,29 @@ namespace {
 
         TypeParam::benchmark("advection_pdbott_prepare_tracers", comp);
     }
+
+    GT_REGRESSION_TEST(advection_pdbott_prepare_tracers_concurrent, test_environment<>, stencil_backend_t) {
+        std::vector<typename TypeParam::storage_type> in, out;
+
+        for (size_t i = 0; i < 40; ++i) {
+            out.push_back(TypeParam::make_storage());
+            in.push_back(TypeParam::make_storage(i));
+        }
+
+        auto comp = [&, grid = TypeParam::make_grid(), rho = TypeParam::make_const_storage(1.1)] {
+            concurrent_expandable_run(
+                [](auto out, auto in, auto rho) { return execute_parallel().stage(prepare_tracers(), out, in, rho); },
+                stencil_backend_t(),
+                grid,
+                out,
+                in,
+                rho);
+        };
+
+        comp();
+        for (size_t i = 0; i != out.size(); ++i)
+            TypeParam::verify([i](int, int, int) { return 1.1 * i; }, out[i]);
+
+        TypeParam::benchmark("advection_pdbott_prepare_tracers_concurrent", comp);
+    }
 } // namespace
@@ -9,6 +9,8 @@
  */
 
 #include <gridtools/boundaries/boundary.hpp>
+#include <gridtools/boundaries/copy.hpp>
+#include <gridtools/boundaries/fused_apply.hpp>
 
 #include <gcl_select.hpp>
 #include <test_environment.hpp>
@@ -141,4 +143,96 @@ namespace {
 
         TypeParam::benchmark("distributed_boundary", testee);
     }
+
+#ifdef GT_GCL_CPU
+    GT_REGRESSION_TEST(distributed_boundary_fused, test_environment<halo_size>, gcl_arch_t) {
+        auto src = TypeParam::make_storage([](int i, int j, int k) { return i + j + k; });
+        auto dst = TypeParam::make_storage(0);
+
+        auto &&lengths = src->info().lengths();
+        auto &&total_lengths = make_total_lengths(*src);
+        array<halo_descriptor, 3> halos;
+        for (size_t i = 0; i != 3; ++i)
+            halos[i] = {halo_size, halo_size, halo_size, lengths[i] - halo_size - 1, total_lengths[i]};
+
+        auto testee = [&] {
+            fused_boundary_apply<>(halos).apply(make_boundary_job(
+                direction_bc_input<typename TypeParam::float_t>(), src->target_view(), dst->target_view()));
+        };
+
+        testee();
+        verify_result(halos, src, dst);
+
+        TypeParam::benchmark("distributed_boundary_fused", testee);
+    }
+
+    // several fields with thin halos: one `boundary` call per field versus a single fused call
+    constexpr auto num_fields = 4;
+    constexpr auto thin_halo_size = 1;
+
+    template <class TypeParam>
+    auto make_thin_halos() {
+        auto &&storage = TypeParam::make_storage();
+        auto &&lengths = storage->info().lengths();
+        auto &&total_lengths = make_total_lengths(*storage);
+        array<halo_descriptor, 3> halos;
+        for (size_t i = 0; i != 3; ++i)
+            halos[i] = {
+                thin_halo_size, thin_halo_size, thin_halo_size, lengths[i] - thin_halo_size - 1, total_lengths[i]};
+        return halos;
+    }
+
+    template <class TypeParam, class Fields>
+    void verify_copied(array<halo_descriptor, 3> const &halos, Fields const &fields) {
+        for (auto const &field : fields) {
+            auto v = field->const_host_view();
+            for (int i = 0; i <= (int)(halos[0].end() + halos[0].plus()); ++i)
+                for (int j = 0; j <= (int)(halos[1].end() + halos[1].plus()); ++j)
+                    for (int k = 0; k <= (int)(halos[2].end() + halos[2].plus()); ++k) {
+                        bool in_halo = i < (int)halos[0].begin() || i > (int)halos[0].end() ||
+                                       j < (int)halos[1].begin() || j > (int)halos[1].end() ||
+                                       k < (int)halos[2].begin() || k > (int)halos[2].end();
+                        EXPECT_EQ(v(i, j, k), in_halo ? i + j + k : 0);
+                    }
+        }
+    }
+
+    GT_REGRESSION_TEST(distributed_boundary_multi_field, test_environment<thin_halo_size>, gcl_arch_t) {
+        auto src = TypeParam::make_storage([](int i, int j, int k) { return i + j + k; });
+        std::array<decltype(src), num_fields> fields;
+        for (auto &field : fields)
+            field = TypeParam::make_storage(0);
+        auto halos = make_thin_halos<TypeParam>();
+
+        auto testee = [&] {
+            for (auto &field : fields)
+                make_boundary<gcl_arch_t>(halos, copy_boundary()).apply(field, src);
+        };
+
+        testee();
+        verify_copied<TypeParam>(halos, fields);
+
+        TypeParam::benchmark("distributed_boundary_multi_field", testee);
+    }
+
+    GT_REGRESSION_TEST(distributed_boundary_multi_field_fused, test_environment<thin_halo_size>, gcl_arch_t) {
+        auto src = TypeParam::make_storage([](int i, int j, int k) { return i + j + k; });
+        std::array<decltype(src), num_fields> fields;
+        for (auto &field : fields)
+            field = TypeParam::make_storage(0);
+        auto halos = make_thin_halos<TypeParam>();
+
+        auto testee = [&] {
+            auto job = [&](auto &field) {
+                return make_boundary_job(copy_boundary(), field->target_view(), src->const_target_view());
+            };
+            fused_boundary_apply<>(halos).apply(job(fields[0]), job(fields[1]), job(fields[2]), job(fields[3]));
+        };
+
+        testee();
+        verify_copied<TypeParam>(halos, fields);
+
+        TypeParam::benchmark("distributed_boundary_multi_field_fused", testee);
+    }
+#endif
 } // namespace
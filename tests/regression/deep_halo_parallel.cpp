@@ -0,0 +1,133 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <gridtools/boundaries/comm_traits.hpp>
+#include <gridtools/boundaries/distributed_boundaries.hpp>
+#include <gridtools/common/array.hpp>
+#include <gridtools/gcl/GCL.hpp>
+#include <gridtools/stencil/cartesian.hpp>
+#include <gridtools/storage/builder.hpp>
+#include <gridtools/storage/sid.hpp>
+
+#include <gcl_select.hpp>
+#include <stencil_select.hpp>
+#include <timer_select.hpp>
+
+/** @file
+    @brief Periodic diffusion with deep halos: the halos are exchanged every `cadence` steps and the stencil is
+    computed redundantly on the shrinking extended domain in between. The result must not depend on the cadence,
+    the time per step is printed to find the crossover between saved messages and redundant computation. */
+
+using namespace gridtools;
+using namespace stencil;
+using namespace cartesian;
+
+namespace {
+    constexpr int nx = 24, ny = 24, nz = 8;
+    constexpr int steps = 120;
+    constexpr int max_cadence = 4;
+
+    struct diffusion {
+        using in = in_accessor<0, extent<-1, 1, -1, 1>>;
+        using out = inout_accessor<1>;
+        using param_list = make_param_list<in, out>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation &eval) {
+            eval(out()) = eval(in()) + .1 * (eval(in(-1, 0)) + eval(in(1, 0)) + eval(in(0, -1)) + eval(in(0, 1)) -
+                                                4 * eval(in()));
+        }
+    };
+
+    const auto spec = [](auto in, auto out) { return execute_parallel().stage(diffusion(), in, out); };
+
+    struct in_plh {};
+    struct out_plh {};
+    using extent_t = decltype(get_arg_extent(spec(in_plh(), out_plh()), in_plh()));
+
+    MPI_Comm cart_comm() {
+        array<int, 3> dims{0, 0, 1};
+        int period[3] = {1, 1, 1};
+        MPI_Dims_create(gcl::procs(), 2, &dims[0]);
+        MPI_Comm res;
+        MPI_Cart_create(gcl::world(), 3, &dims[0], period, false, &res);
+        return res;
+    }
+
+    // runs the diffusion and returns the interior of the result and the time per step
+    std::pair<std::vector<double>, double> diffuse(MPI_Comm comm, int cadence) {
+        uint_t halo = cadence * -extent_t::iminus::value;
+        auto in = storage::builder<storage_traits_t>.type<double>().dimensions(
+            nx + 2 * halo, ny + 2 * halo, nz)();
+        auto out = storage::builder<storage_traits_t>.type<double>().dimensions(
+            nx + 2 * halo, ny + 2 * halo, nz)();
+
+        auto total_lengths = make_total_lengths(*in);
+        array<halo_descriptor, 3> halos{{{halo, halo, halo, nx + halo - 1, uint_t(total_lengths[0])},
+            {halo, halo, halo, ny + halo - 1, uint_t(total_lengths[1])},
+            {0, 0, 0, nz - 1, uint_t(total_lengths[2])}}};
+        boundaries::distributed_boundaries<boundaries::comm_traits<decltype(in), gcl_arch_t, timer_impl_t>> db(
+            halos, {true, true, false}, 1, comm, cadence);
+
+        int pi, pj, pk;
+        db.proc_grid().coords(pi, pj, pk);
+        {
+            auto view = in->host_view();
+            for (int i = 0; i < nx; ++i)
+                for (int j = 0; j < ny; ++j)
+                    for (int k = 0; k < nz; ++k)
+                        view(i + halo, j + halo, k) = std::sin(.3 * (i + pi * nx)) * std::cos(.2 * (j + pj * ny)) + k;
+        }
+
+        MPI_Barrier(comm);
+        auto start = std::chrono::steady_clock::now();
+        for (int step = 0; step != steps; ++step) {
+            db.exchange(in);
+            auto compute = db.compute_halos(extent_t());
+            run(spec, stencil_backend_t(), make_grid(compute[0], compute[1], nz), in, out);
+            std::swap(in, out);
+        }
+        MPI_Barrier(comm);
+        double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / steps;
+
+        EXPECT_EQ(db.get_count_exchange(), (steps + cadence - 1) / cadence);
+
+        std::vector<double> res;
+        auto view = in->const_host_view();
+        for (int i = 0; i < nx; ++i)
+            for (int j = 0; j < ny; ++j)
+                for (int k = 0; k < nz; ++k)
+                    res.push_back(view(i + halo, j + halo, k));
+        return {res, time};
+    }
+
+    TEST(deep_halo_parallel, cadence) {
+        MPI_Comm comm = cart_comm();
+        auto expected = diffuse(comm, 1);
+        testing::Test::RecordProperty("cadence_1_us_per_step", std::to_string(expected.second * 1e6));
+        for (int cadence = 2; cadence <= max_cadence; ++cadence) {
+            auto actual = diffuse(comm, cadence);
+            testing::Test::RecordProperty(
+                "cadence_" + std::to_string(cadence) + "_us_per_step", std::to_string(actual.second * 1e6));
+            ASSERT_EQ(actual.first.size(), expected.first.size());
+            for (std::size_t i = 0; i != expected.first.size(); ++i)
+                EXPECT_DOUBLE_EQ(actual.first[i], expected.first[i]) << "cadence " << cadence << " index " << i;
+        }
+        MPI_Comm_free(&comm);
+    }
+} // namespace
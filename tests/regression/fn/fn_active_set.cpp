@@ -0,0 +1,121 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/fn/cartesian.hpp>
+
+#include <fn_select.hpp>
+#include <test_environment.hpp>
+
+#include "../horizontal_diffusion_repository.hpp"
+
+// Horizontal diffusion on a subset of the columns, either with the mask tested inside the stencil on the dense domain
+// or with the active set of the columns. The time per run of both variants at several densities of the active
+// columns is reported as the `dense_<percent>_us` and `sparse_<percent>_us` test properties.
+namespace {
+    using namespace gridtools;
+    using namespace fn;
+    using namespace cartesian;
+    using namespace literals;
+
+    constexpr auto hdiff_fused = [](auto const &in, auto const &coeff) {
+        constexpr auto i = cartesian::dim::i();
+        constexpr auto j = cartesian::dim::j();
+        auto lap = [&](auto const &it) {
+            return 4 * deref(it) - (deref(shift(it, i, 1)) + deref(shift(it, i, -1)) + deref(shift(it, j, 1)) +
+                                       deref(shift(it, j, -1)));
+        };
+        auto flux = [&](auto d, auto const &it) {
+            auto tmp = lap(shift(it, d, 1)) - lap(it);
+            return tmp * (deref(shift(it, d, 1)) - deref(it)) > 0 ? 0 : tmp;
+        };
+        auto flx = flux(i, in);
+        auto flx_im1 = flux(i, shift(in, i, -1));
+        auto fly = flux(j, in);
+        auto fly_jm1 = flux(j, shift(in, j, -1));
+        return deref(in) - deref(coeff) * (flx - flx_im1 + fly - fly_jm1);
+    };
+
+    struct hdiff {
+        GT_FUNCTION constexpr auto operator()() const { return hdiff_fused; }
+    };
+
+    struct masked_hdiff {
+        GT_FUNCTION constexpr auto operator()() const {
+            return [](auto const &mask, auto const &in, auto const &coeff) {
+                return deref(mask) ? hdiff_fused(in, coeff) : decltype(deref(in))(0);
+            };
+        }
+    };
+
+    // scattered pattern with about `percent` % active columns
+    auto is_active(int percent) {
+        return [percent](int i, int j) { return (i * 7919 + j * 104729) % 100 < percent; };
+    }
+
+    template <class Comp>
+    double time_per_run_us(Comp const &comp) {
+        constexpr int runs = 10;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i != runs; ++i)
+            comp();
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+    }
+
+    GT_REGRESSION_TEST(fn_active_set, test_environment<2>, fn_backend_t) {
+        using sizes_t = hymap::keys<dim::i, dim::j, dim::k>::values<int, int, int>;
+        horizontal_diffusion_repository repo(TypeParam::d(0), TypeParam::d(1), TypeParam::d(2));
+        auto in = TypeParam::make_const_storage(repo.in);
+        auto coeff = TypeParam::make_const_storage(repo.coeff);
+        sizes_t sizes = {TypeParam::d(0) - 4, TypeParam::d(1) - 4, TypeParam::d(2)};
+        sizes_t offsets = {2, 2, 0};
+
+        for (int percent : {1, 10, 50, 100}) {
+            auto active = [f = is_active(percent)](int i, int j) { return f(i - 2, j - 2); };
+            auto mask = TypeParam::template make_const_storage<bool>(
+                [&](int i, int j, int) { return i >= 2 && j >= 2 && active(i, j); });
+            auto expected = [&](int i, int j, int k) { return active(i, j) ? repo.out(i, j, k) : 0; };
+
+            auto dense_out = TypeParam::make_storage(0);
+            auto dense = [&, backend = make_backend(fn_backend_t(), cartesian_domain(sizes, offsets))] {
+                backend.stencil_executor()()
+                    .arg(dense_out)
+                    .arg(mask)
+                    .arg(in)
+                    .arg(coeff)
+                    .assign(0_c, masked_hdiff(), 1_c, 2_c, 3_c)
+                    .execute();
+            };
+            dense();
+            TypeParam::verify(expected, dense_out);
+
+            active_set set(at_key<dim::i>(sizes), at_key<dim::j>(sizes), is_active(percent));
+            auto sparse_out = TypeParam::make_storage(0);
+            auto sparse = [&, backend = make_backend(fn_backend_t(), cartesian_active_domain(sizes, set, offsets))] {
+                backend.stencil_executor()()
+                    .arg(sparse_out)
+                    .arg(in)
+                    .arg(coeff)
+                    .assign(0_c, hdiff(), 1_c, 2_c)
+                    .execute();
+            };
+            sparse();
+            TypeParam::verify(expected, sparse_out);
+
+            auto suffix = std::to_string(percent) + "_us";
+            testing::Test::RecordProperty("dense_" + suffix, std::to_string(time_per_run_us(dense)));
+            testing::Test::RecordProperty("sparse_" + suffix, std::to_string(time_per_run_us(sparse)));
+        }
+    }
+} // namespace
@@ -0,0 +1,107 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gtest/gtest.h>
+
+#include <gridtools/common/tuple.hpp>
+#include <gridtools/common/tuple_util.hpp>
+#include <gridtools/fn/cartesian.hpp>
+#include <gridtools/sid/dimension_to_soa.hpp>
+#include <gridtools/sid/dimension_to_tuple_like.hpp>
+
+#include <fn_select.hpp>
+#include <test_environment.hpp>
+
+namespace {
+    using namespace gridtools;
+    using namespace fn;
+    using namespace cartesian;
+    using namespace literals;
+
+    // horizontal smoothing of a three-component wind vector field
+    struct smooth {
+        GT_FUNCTION constexpr auto operator()() const {
+            return [](auto const &in) {
+                auto c = deref(in);
+                auto ip = deref(shift(in, dim::i(), 1));
+                auto im = deref(shift(in, dim::i(), -1));
+                auto jp = deref(shift(in, dim::j(), 1));
+                auto jm = deref(shift(in, dim::j(), -1));
+                auto f = [&](auto n) {
+                    using tuple_util::host_device::get;
+                    return get<decltype(n)::value>(c) / 2 +
+                           (get<decltype(n)::value>(ip) + get<decltype(n)::value>(im) + get<decltype(n)::value>(jp) +
+                               get<decltype(n)::value>(jm)) /
+                               8;
+                };
+                return tuple(f(0_c), f(1_c), f(2_c));
+            };
+        }
+    };
+
+    constexpr inline auto wind = [](int i, int j, int k, int c) { return (i * i + 3 * j + k) * (c + 1) % 17; };
+
+    constexpr inline auto expected = [](int i, int j, int k, int c) {
+        return wind(i, j, k, c) / 2. +
+               (wind(i + 1, j, k, c) + wind(i - 1, j, k, c) + wind(i, j + 1, k, c) + wind(i, j - 1, k, c)) / 8.;
+    };
+
+    template <class TypeParam, class Out, class In>
+    void apply_smooth(Out &out, In &in) {
+        using sizes_t = hymap::keys<dim::i, dim::j, dim::k>::values<int, int, int>;
+        auto domain = cartesian_domain(
+            sizes_t{int(TypeParam::d(0)) - 2, int(TypeParam::d(1)) - 2, int(TypeParam::d(2))}, sizes_t{1, 1, 0});
+        auto backend = make_backend(fn_backend_t(), domain);
+        backend.stencil_executor()().arg(out).arg(in).assign(0_c, smooth(), 1_c).execute();
+    }
+
+    GT_REGRESSION_TEST(fn_cartesian_wind_aos, test_environment<1>, fn_backend_t) {
+        using float_t = typename TypeParam::float_t;
+        using vector_t = tuple<float_t, float_t, float_t>;
+        auto out = TypeParam::template make_storage<vector_t>();
+        auto comp = [&,
+                        in = TypeParam::template make_const_storage<vector_t>([](int i, int j, int k) {
+                            return vector_t(wind(i, j, k, 0), wind(i, j, k, 1), wind(i, j, k, 2));
+                        })]() mutable { apply_smooth<TypeParam>(out, in); };
+        comp();
+        auto expected_vector = [](int i, int j, int k) {
+            return vector_t(expected(i, j, k, 0), expected(i, j, k, 1), expected(i, j, k, 2));
+        };
+        TypeParam::verify(expected_vector, out);
+        TypeParam::benchmark("fn_cartesian_wind_aos", comp);
+    }
+
+    GT_REGRESSION_TEST(fn_cartesian_wind_dim2tuple, test_environment<1>, fn_backend_t) {
+        using float_t = typename TypeParam::float_t;
+        auto out_ds = TypeParam::template builder<float_t>(3_c).build();
+        auto out = sid::dimension_to_tuple_like<integral_constant<int, 3>, 3>(out_ds);
+        auto comp = [&,
+                        in = sid::dimension_to_tuple_like<integral_constant<int, 3>, 3>(
+                            TypeParam::template builder<float_t const>(3_c).initializer(wind).build())]() mutable {
+            apply_smooth<TypeParam>(out, in);
+        };
+        comp();
+        TypeParam::verify(expected, out_ds);
+        TypeParam::benchmark("fn_cartesian_wind_dim2tuple", comp);
+    }
+
+    GT_REGRESSION_TEST(fn_cartesian_wind_soa, test_environment<1>, fn_backend_t) {
+        using float_t = typename TypeParam::float_t;
+        auto out_ds = TypeParam::template builder<float_t>(3_c).build();
+        auto out = sid::dimension_to_soa<integral_constant<int, 3>, 3>(out_ds);
+        auto comp = [&,
+                        in = sid::dimension_to_soa<integral_constant<int, 3>, 3>(
+                            TypeParam::template builder<float_t const>(3_c).initializer(wind).build())]() mutable {
+            apply_smooth<TypeParam>(out, in);
+        };
+        comp();
+        TypeParam::verify(expected, out_ds);
+        TypeParam::benchmark("fn_cartesian_wind_soa", comp);
+    }
+} // namespace
@@ -47,6 +47,19 @@ namespace {
         TypeParam::benchmark("fn_cartesian_copy", comp);
     }
 
+    GT_REGRESSION_TEST(fn_cartesian_copy_prepared, test_environment<>, fn_backend_t) {
+        auto out = TypeParam::make_storage();
+        auto in = TypeParam::make_const_storage(::in);
+        auto domain = cartesian_domain(TypeParam::fn_cartesian_sizes());
+        auto backend = make_backend(fn_backend_t(), domain);
+        auto prepared = backend.stencil_executor()().arg(out).arg(in).assign(0_c, copy_stencil(), 1_c).prepare();
+
+        auto comp = [&] { prepared.execute(); };
+        comp();
+        TypeParam::verify(::in, out);
+        TypeParam::benchmark("fn_cartesian_copy_prepared", comp);
+    }
+
     GT_REGRESSION_TEST(fn_cartesian_copy_with_domain_offsets, test_environment<>, fn_backend_t) {
         auto out = TypeParam::make_storage([](int i, int j, int k) { return -in(i, j, k); });
         auto fencil = [&](auto const &sizes, auto const &offsets, auto &out, auto const &in) {
@@ -10,6 +10,7 @@
 
 #include <gtest/gtest.h>
 
+#include <gridtools/fn/csr_neighbor_table.hpp>
 #include <gridtools/fn/sid_neighbor_table.hpp>
 #include <gridtools/fn/unstructured.hpp>
 #include <gridtools/sid/dimension_to_tuple_like.hpp>
@@ -60,6 +61,27 @@ namespace {
         }
     };
 
+    struct nabla_stencil_reduction {
+        constexpr auto operator()() const {
+            return [](auto const &zavg, auto const &sign, auto const &vol) {
+                using float_t = std::decay_t<decltype(deref(vol))>;
+                auto signs = deref(sign);
+                auto tmp = neighbor_reduction(
+                    zavg,
+                    v2e(),
+                    [&](tuple<float_t, float_t> acc, auto const &shifted_zavg, int i) {
+                        auto const value = deref(shifted_zavg);
+                        tuple_get(0_c, acc) += tuple_get(0_c, value) * signs[i];
+                        tuple_get(1_c, acc) += tuple_get(1_c, value) * signs[i];
+                        return acc;
+                    },
+                    tuple<float_t, float_t>(0, 0));
+                auto v = deref(vol);
+                return make_tuple(tuple_get(0_c, tmp) / v, tuple_get(1_c, tmp) / v);
+            };
+        }
+    };
+
     struct nabla_stencil_fused {
         constexpr auto operator()() const {
             return [](auto const &sign, auto const &vol, auto const &pp, auto const &s) {
@@ -128,6 +150,16 @@ namespace {
         [](auto executor, auto &nabla, auto const &zavg, auto const &sign, auto const &vol) {
             executor().arg(nabla).arg(zavg).arg(sign).arg(vol).assign(0_c, nabla_stencil(), 1_c, 2_c, 3_c).execute();
         };
+    constexpr inline auto apply_nabla_reduction =
+        [](auto executor, auto &nabla, auto const &zavg, auto const &sign, auto const &vol) {
+            executor()
+                .arg(nabla)
+                .arg(zavg)
+                .arg(sign)
+                .arg(vol)
+                .assign(0_c, nabla_stencil_reduction(), 1_c, 2_c, 3_c)
+                .execute();
+        };
     constexpr inline auto apply_nabla_fused =
         [](auto executor, auto &nabla, auto const &sign, auto const &vol, auto const &pp, auto const &s) {
             executor()
@@ -164,6 +196,30 @@ namespace {
         apply_nabla(vertex_backend.stencil_executor(), nabla, zavg, sign, vol);
     };
 
+    constexpr inline auto fencil_reduction = [](auto backend,
+                                                 int nvertices,
+                                                 int nedges,
+                                                 int nlevels,
+                                                 auto const &v2e_table,
+                                                 auto const &e2v_table,
+                                                 auto &nabla,
+                                                 auto const &pp,
+                                                 auto const &s,
+                                                 auto const &sign,
+                                                 auto const &vol) {
+        using float_t = std::remove_const_t<sid::element_type<decltype(pp)>>;
+        auto v2e_conn = connectivity<v2e>(v2e_table);
+        auto e2v_conn = connectivity<e2v>(e2v_table);
+        auto edge_domain = unstructured_domain({nedges, nlevels}, {}, e2v_conn);
+        auto vertex_domain = unstructured_domain({nvertices, nlevels}, {}, v2e_conn);
+        auto edge_backend = make_backend(backend, edge_domain);
+        auto vertex_backend = make_backend(backend, vertex_domain);
+        auto alloc = tmp_allocator(backend);
+        auto zavg = allocate_global_tmp<tuple<float_t, float_t>>(alloc, edge_domain.sizes());
+        apply_zavg(edge_backend.stencil_executor(), zavg, pp, s);
+        apply_nabla_reduction(vertex_backend.stencil_executor(), nabla, zavg, sign, vol);
+    };
+
     constexpr inline auto fencil_fused = [](auto backend,
                                              int nvertices,
                                              int nlevels,
@@ -239,6 +295,42 @@ namespace {
             };
     };
 
+    // computes nabla with `neighbor_reduction`, using either the padded or the CSR v2e table
+    template <bool UseCsr>
+    constexpr inline auto make_comp_reduction = [](auto backend, auto const &mesh, auto &nabla) {
+        using mesh_t = std::remove_reference_t<decltype(mesh)>;
+        using float_t = typename mesh_t::float_t;
+        return
+            [backend,
+                &nabla,
+                nvertices = mesh.nvertices(),
+                nedges = mesh.nedges(),
+                nlevels = mesh.nlevels(),
+                v2e_table = mesh.v2e_table(),
+                v2e_offsets = mesh.v2e_csr_offsets(),
+                v2e_indices = mesh.v2e_csr_indices(),
+                e2v_table = mesh.e2v_table(),
+                pp = mesh.template make_const_storage<float_t, vertex_field_id>(pp, mesh.nvertices(), mesh.nlevels()),
+                sign = mesh.template make_const_storage<array<float_t, 6>>(sign, mesh.nvertices()),
+                vol = mesh.make_const_storage(vol, mesh.nvertices()),
+                s = mesh.template make_const_storage<tuple<float_t, float_t>>(s, mesh.nedges(), mesh.nlevels())] {
+                auto e2v_ptr = sid_neighbor_table::as_neighbor_table<integral_constant<int, 0>,
+                    integral_constant<int, 1>,
+                    mesh_t::max_e2v_neighbors_t::value>(e2v_table);
+                if constexpr (UseCsr) {
+                    auto v2e_ptr = csr_neighbor_table::
+                        as_neighbor_table<integral_constant<int, 0>, mesh_t::max_v2e_neighbors_t::value>(
+                            v2e_offsets, v2e_indices);
+                    fencil_reduction(backend, nvertices, nedges, nlevels, v2e_ptr, e2v_ptr, nabla, pp, s, sign, vol);
+                } else {
+                    auto v2e_ptr = sid_neighbor_table::as_neighbor_table<integral_constant<int, 0>,
+                        integral_constant<int, 1>,
+                        mesh_t::max_v2e_neighbors_t::value>(v2e_table);
+                    fencil_reduction(backend, nvertices, nedges, nlevels, v2e_ptr, e2v_ptr, nabla, pp, s, sign, vol);
+                }
+            };
+    };
+
     constexpr inline auto make_expected = [](auto const &mesh) {
         return [v2e_table = mesh.v2e_table(), e2v_table = mesh.e2v_table()](int vertex, int k) {
             auto v2e = v2e_table->const_host_view();
@@ -259,6 +351,30 @@ namespace {
         TypeParam::benchmark("fn_unstructured_nabla_field_of_tuples", comp);
     }
 
+    GT_REGRESSION_TEST(fn_unstructured_nabla_padded_reduction, test_environment<>, fn_backend_t) {
+        using float_t = typename TypeParam::float_t;
+
+        auto mesh = TypeParam::fn_unstructured_mesh();
+        auto nabla = mesh.template make_storage<tuple<float_t, float_t>>(mesh.nvertices(), mesh.nlevels());
+        auto comp = make_comp_reduction<false>(fn_backend_t(), mesh, nabla);
+        comp();
+        auto expected = make_expected(mesh);
+        TypeParam::verify(expected, nabla);
+        TypeParam::benchmark("fn_unstructured_nabla_padded_reduction", comp);
+    }
+
+    GT_REGRESSION_TEST(fn_unstructured_nabla_csr_reduction, test_environment<>, fn_backend_t) {
+        using float_t = typename TypeParam::float_t;
+
+        auto mesh = TypeParam::fn_unstructured_mesh();
+        auto nabla = mesh.template make_storage<tuple<float_t, float_t>>(mesh.nvertices(), mesh.nlevels());
+        auto comp = make_comp_reduction<true>(fn_backend_t(), mesh, nabla);
+        comp();
+        auto expected = make_expected(mesh);
+        TypeParam::verify(expected, nabla);
+        TypeParam::benchmark("fn_unstructured_nabla_csr_reduction", comp);
+    }
+
     GT_REGRESSION_TEST(fn_unstructured_nabla_fused_field_of_tuples, test_environment<>, k_blocked_backend_t) {
         using float_t = typename TypeParam::float_t;
 
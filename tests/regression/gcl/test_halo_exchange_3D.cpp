@@ -9,6 +9,7 @@
  */
 #include <gridtools/gcl/halo_exchange.hpp>
 
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 
@@ -192,6 +193,62 @@ TEST_P(halo_exchange_3D_all, test) {
     });
 }
 
+#ifdef GT_GCL_CPU
+TEST_P(halo_exchange_3D_all, shared_memory) {
+    run_exchanges([&](auto layout, auto use_vector_interface, auto &&storages, auto... periodicity) {
+        using testee_t = gcl::halo_exchange_dynamic_ut_shm<decltype(layout), layout_map<0, 1, 2>, value_type>;
+        testee_t testee({periodicity...}, CartComm);
+        auto halo_descriptors = make_halo_descriptors(storages, 0);
+        for_each<meta::make_indices_c<num_fields>>(
+            [&](auto f) { testee.template add_halo<decltype(f)::value>(halo_descriptors[f.value]); });
+        testee.setup(3);
+        auto field = [&](int f) { return storages[f]->get_target_ptr(); };
+        // exchanging twice checks that the shared slots are released by the receivers
+        exchange(use_vector_interface, testee, field(0), field(1), field(2));
+        exchange(use_vector_interface, testee, field(0), field(1), field(2));
+    });
+}
+
+// every rank sends more bytes than its neighbors registered for receiving
+TEST(halo_exchange_3D_shm, oversized_send_throws) {
+    // ranks on other nodes take the plain MPI path, which does not check the size
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+    int node_size, world_size;
+    MPI_Comm_size(node_comm, &node_size);
+    MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+    MPI_Comm_free(&node_comm);
+    if (node_size != world_size)
+        GTEST_SKIP() << "the ranks do not share a node";
+
+    using proc_grid_t = gcl::MPI_3D_process_grid_t<3>;
+    proc_grid_t proc_grid({true, true, true}, MPI_COMM_WORLD, array<int, 3>{});
+    gcl::Halo_Exchange_3D_SHM<proc_grid_t> testee(proc_grid);
+    char recv_buffer[8], send_buffer[16] = {};
+    for (int i = -1; i <= 1; ++i)
+        for (int j = -1; j <= 1; ++j)
+            for (int k = -1; k <= 1; ++k)
+                if (i != 0 || j != 0 || k != 0) {
+                    testee.register_receive_from_buffer(recv_buffer, sizeof(recv_buffer), i, j, k);
+                    testee.register_send_to_buffer(send_buffer, sizeof(send_buffer), i, j, k);
+                }
+    EXPECT_THROW(testee.exchange(), std::runtime_error);
+}
+
+TEST_P(halo_exchange_3D_all, datatype) {
+    run_exchanges([&](auto layout, auto use_vector_interface, auto &&storages, auto... periodicity) {
+        using testee_t = gcl::halo_exchange_dynamic_ut_dt<decltype(layout), layout_map<0, 1, 2>, value_type>;
+        testee_t testee({periodicity...}, CartComm);
+        auto halo_descriptors = make_halo_descriptors(storages, 0);
+        for_each<meta::make_indices_c<num_fields>>(
+            [&](auto f) { testee.template add_halo<decltype(f)::value>(halo_descriptors[f.value]); });
+        testee.setup(3);
+        auto field = [&](int f) { return storages[f]->get_target_ptr(); };
+        exchange(use_vector_interface, testee, field(0), field(1), field(2));
+    });
+}
+#endif
+
 INSTANTIATE_TEST_SUITE_P(tests,
     halo_exchange_3D_all,
     testing::Values(test_spec{.dims = {123, 56, 76},
@@ -0,0 +1,113 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/gcl/heterogeneous_halo_exchange.hpp>
+
+#include <mpi.h>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/common/array.hpp>
+#include <gridtools/gcl/GCL.hpp>
+#include <gridtools/storage/builder.hpp>
+
+#include <storage_select.hpp>
+
+using namespace gridtools;
+
+namespace {
+    constexpr int nx = 13, ny = 10, nz = 5;
+
+    struct heterogeneous_halo_exchange_test : testing::Test {
+        MPI_Comm comm;
+        int dims[3] = {0, 0, 1};
+        int coords[3];
+
+        heterogeneous_halo_exchange_test() {
+            int period[3] = {1, 1, 1};
+            MPI_Dims_create(gcl::procs(), 2, dims);
+            MPI_Cart_create(gcl::world(), 3, dims, period, false, &comm);
+            MPI_Cart_get(comm, 3, dims, period, coords);
+        }
+
+        ~heterogeneous_halo_exchange_test() { MPI_Comm_free(&comm); }
+
+        // value at the global (periodic) position of the local index i, j, k of a field with the given halos
+        template <class T>
+        T value(int i, int j, int k, int hi, int hj) const {
+            int gi = (i - hi + coords[0] * nx + dims[0] * nx) % (dims[0] * nx);
+            int gj = (j - hj + coords[1] * ny + dims[1] * ny) % (dims[1] * ny);
+            return T((gi * 100 + gj) * 10 + k);
+        }
+
+        template <class T>
+        auto make_storage(int hi, int hj) const {
+            return storage::builder<storage_traits_t>
+                .template type<T>()
+                .dimensions(nx + 2 * hi, ny + 2 * hj, nz)
+                .initializer([=](int i, int j, int k) {
+                    bool interior = i >= hi && i < nx + hi && j >= hj && j < ny + hj;
+                    return interior ? value<T>(i, j, k, hi, hj) : T(-1);
+                })
+                .build();
+        }
+
+        template <class Storage>
+        static array<halo_descriptor, 3> halos(Storage const &storage, uint_t hi, uint_t hj) {
+            auto total_lengths = make_total_lengths(*storage);
+            return {{{hi, hi, hi, nx + hi - 1, uint_t(total_lengths[0])},
+                {hj, hj, hj, ny + hj - 1, uint_t(total_lengths[1])},
+                {0, 0, 0, nz - 1, uint_t(total_lengths[2])}}};
+        }
+
+        template <class Storage>
+        void verify(Storage const &storage, int hi, int hj) const {
+            using data_t = typename Storage::element_type::data_t;
+            auto view = storage->const_host_view();
+            for (int i = 0; i != nx + 2 * hi; ++i)
+                for (int j = 0; j != ny + 2 * hj; ++j)
+                    for (int k = 0; k != nz; ++k)
+                        EXPECT_EQ(view(i, j, k), value<data_t>(i, j, k, hi, hj))
+                            << "pid " << gcl::pid() << " i " << i << " j " << j << " k " << k;
+        }
+    };
+
+    TEST_F(heterogeneous_halo_exchange_test, types_and_halos) {
+        auto tracer = make_storage<float>(2, 1);
+        auto mask = make_storage<int>(1, 3);
+        auto pressure = make_storage<double>(3, 2);
+
+        gcl::heterogeneous_halo_exchange<> testee({true, true, false}, comm);
+        // twice, to check that the buffers are reused
+        for (int step = 0; step != 2; ++step)
+            testee.exchange(gcl::halo_field(tracer, halos(tracer, 2, 1)),
+                gcl::halo_field(mask, halos(mask, 1, 3)),
+                gcl::halo_field(pressure, halos(pressure, 3, 2)));
+
+        verify(tracer, 2, 1);
+        verify(mask, 1, 3);
+        verify(pressure, 3, 2);
+    }
+
+    TEST_F(heterogeneous_halo_exchange_test, split_phase) {
+        auto mask = make_storage<int>(1, 1);
+        auto pressure = make_storage<double>(2, 2);
+        auto mask_field = gcl::halo_field(mask, halos(mask, 1, 1));
+        auto pressure_field = gcl::halo_field(pressure, halos(pressure, 2, 2));
+
+        gcl::heterogeneous_halo_exchange<> testee({true, true, false}, comm);
+        testee.pack(mask_field, pressure_field);
+        testee.start_exchange();
+        testee.wait();
+        testee.unpack(mask_field, pressure_field);
+
+        verify(mask, 1, 1);
+        verify(pressure, 2, 2);
+    }
+} // namespace
@@ -0,0 +1,110 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/gcl/unstructured_halo_exchange.hpp>
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <mpi.h>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/storage/builder.hpp>
+#include <gridtools/storage/sid.hpp>
+
+#include <fn_mesh.hpp>
+#include <storage_select.hpp>
+
+using namespace gridtools;
+
+namespace {
+    constexpr int nx = 17, ny = 23, nz = 5;
+
+    // vertices partitioned by rows, the ghosts are the vertices sharing an edge with an owned vertex
+    struct partition {
+        std::vector<int> global_indices;
+        std::size_t num_owned;
+
+        partition(int rank, int size) {
+            structured_unstructured_mesh<storage_traits_t, double> mesh(nx, ny, nz);
+            auto v2e_table = mesh.v2e_table();
+            auto e2v_table = mesh.e2v_table();
+            auto v2e = v2e_table->const_host_view();
+            auto e2v = e2v_table->const_host_view();
+            int first = ny * rank / size * nx;
+            int last = ny * (rank + 1) / size * nx;
+            std::set<int> ghosts;
+            for (int v = first; v != last; ++v) {
+                global_indices.push_back(v);
+                for (int n = 0; n != 6; ++n) {
+                    int e = v2e(v, n);
+                    if (e == -1)
+                        continue;
+                    for (int m = 0; m != 2; ++m)
+                        if (e2v(e, m) < first || e2v(e, m) >= last)
+                            ghosts.insert(e2v(e, m));
+                }
+            }
+            num_owned = global_indices.size();
+            global_indices.insert(global_indices.end(), ghosts.rbegin(), ghosts.rend());
+        }
+    };
+
+    double value(int global, int k) { return global * 100. + k; }
+
+    TEST(unstructured_halo_exchange, vertices) {
+        int rank, size;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &size);
+        partition p(rank, size);
+        int n = p.global_indices.size();
+        auto owned = [&](int i) { return i < int(p.num_owned); };
+
+        auto levels = storage::builder<storage_traits_t>.dimensions(n, nz).type<double>().initializer(
+            [&](int i, int k) { return owned(i) ? value(p.global_indices[i], k) : -1.; }).build();
+        auto ids = storage::builder<storage_traits_t>.dimensions(n).type<int>().initializer(
+            [&](int i) { return owned(i) ? p.global_indices[i] : -1; }).build();
+
+        gcl::unstructured_halo_exchange testee(MPI_COMM_WORLD, p.global_indices, p.num_owned);
+        EXPECT_EQ(testee.num_recv_indices(), n - p.num_owned);
+        EXPECT_LE(testee.num_peers(), 2);
+
+        // twice, to check the cached buffers
+        for (int step = 0; step != 2; ++step) {
+            testee.exchange(levels, ids);
+            auto levels_view = levels->const_host_view();
+            auto ids_view = ids->const_host_view();
+            for (int i = 0; i != n; ++i) {
+                EXPECT_EQ(ids_view(i), p.global_indices[i]) << "rank " << rank << " i " << i;
+                for (int k = 0; k != nz; ++k)
+                    EXPECT_EQ(levels_view(i, k), value(p.global_indices[i], k))
+                        << "rank " << rank << " i " << i << " k " << k;
+            }
+        }
+    }
+
+    TEST(unstructured_halo_exchange, negative_global_index) {
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        // only the ghost of rank 0 is invalid, all ranks throw
+        std::vector<int> global_indices = {rank, rank == 0 ? -1 : 0};
+        EXPECT_THROW(gcl::unstructured_halo_exchange(MPI_COMM_WORLD, global_indices, 1), std::runtime_error);
+    }
+
+    TEST(unstructured_halo_exchange, ghost_without_owner) {
+        int rank, size;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &size);
+        std::vector<int> global_indices = {rank, size};
+        EXPECT_THROW(gcl::unstructured_halo_exchange(MPI_COMM_WORLD, global_indices, 1), std::runtime_error);
+    }
+} // namespace
@@ -0,0 +1,72 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string>
+
+#include <gridtools/stencil/icosahedral.hpp>
+
+#include <stencil_select.hpp>
+#include <test_environment.hpp>
+
+#include "neighbours_of.hpp"
+
+// The neighbor reductions on cells and edges with the default storage layout (colors outermost) and with the colors
+// interleaved innermost (`builder.innermost<3>()`). The benchmarks of the interleaved variants have the `_interleaved`
+// suffix.
+namespace {
+    using namespace gridtools;
+    using namespace stencil;
+    using namespace icosahedral;
+
+    template <class From, class To>
+    struct sum_neighbors_functor {
+        using in = in_accessor<0, To, extent<-1, 1, -1, 1>>;
+        using out = inout_accessor<1, From>;
+        using param_list = make_param_list<in, out>;
+        using location = From;
+
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval) {
+            std::decay_t<decltype(eval(out()))> res = 0;
+            eval.for_neighbors([&](auto in) { res += in; }, in());
+            eval(out()) = res;
+        }
+    };
+
+    template <class Env, class From, class To>
+    void test_sum_neighbors(std::string const &name, From from, To to) {
+        auto in = [](int_t i, int_t j, int_t k, int_t c) { return i + j + k + c; };
+        auto ref = [&](int_t i, int_t j, int_t k, int_t c) {
+            typename Env::float_t res = 0;
+            for (auto &&item : neighbours_of<From, To>(i, j, k, c))
+                res += item.call(in);
+            return res;
+        };
+        auto grid = Env::make_grid();
+        auto run_with = [&](auto set_layout, std::string const &suffix) {
+            auto in_storage = set_layout(Env::icosahedral_builder(to)).initializer(in).build();
+            auto out = set_layout(Env::icosahedral_builder(from)).build();
+            auto comp = [&] {
+                run_single_stage(sum_neighbors_functor<From, To>(), stencil_backend_t(), grid, in_storage, out);
+            };
+            comp();
+            Env::verify(ref, out);
+            Env::benchmark(name + suffix, comp);
+        };
+        run_with([](auto builder) { return builder; }, "");
+        run_with([](auto builder) { return builder.template innermost<3>(); }, "_interleaved");
+    }
+
+    GT_REGRESSION_TEST(color_interleaved, icosahedral_test_environment<1>, stencil_backend_t) {
+        test_sum_neighbors<TypeParam>("cells_of_cells", cells(), cells());
+        test_sum_neighbors<TypeParam>("edges_of_edges", edges(), edges());
+        test_sum_neighbors<TypeParam>("edges_of_cells", cells(), edges());
+    }
+} // namespace
@@ -0,0 +1,92 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <algorithm>
+#include <type_traits>
+
+#include <gridtools/stencil/cartesian.hpp>
+
+#include <stencil_select.hpp>
+#include <test_environment.hpp>
+
+// A chain of forward k-serial multistages on a horizontal domain with fewer j-columns than threads. With the cpu_ifirst
+// backend, the benchmarks compare the regular schedule with the one that pipelines the multistages along k.
+namespace {
+    using namespace gridtools;
+    using namespace stencil;
+    using namespace cartesian;
+
+    using full_t = axis<1>::full_interval;
+
+    struct damped_sum {
+        using in = in_accessor<0>;
+        using out = inout_accessor<1, extent<0, 0, 0, 0, -1, 0>>;
+        using param_list = make_param_list<in, out>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval, full_t::first_level) {
+            eval(out()) = eval(in());
+        }
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval, full_t::modify<1, 0>) {
+            eval(out()) = eval(in()) + eval(out(0, 0, -1)) / 2;
+        }
+    };
+
+    template <class Env>
+    auto get_spec() {
+        return [](auto in, auto out) {
+            GT_DECLARE_TMP(typename Env::float_t, a, b, c);
+            return multi_pass(execute_forward().stage(damped_sum(), in, a),
+                execute_forward().stage(damped_sum(), a, b),
+                execute_forward().stage(damped_sum(), b, c),
+                execute_forward().stage(damped_sum(), c, out));
+        };
+    }
+
+    GT_REGRESSION_TEST(kserial_pipeline, vertical_test_environment<>, stencil_backend_t) {
+        using float_t = typename TypeParam::float_t;
+        auto in = [](int i, int j, int k) { return float_t(i + 2 * j + k % 7); };
+        auto expected = [&](int i, int j, int k) {
+            float_t previous[4] = {};
+            float_t res = 0;
+            for (int kk = 0; kk <= k; ++kk) {
+                res = in(i, j, kk);
+                for (auto &p : previous)
+                    res = p = res + p / 2;
+            }
+            return res;
+        };
+
+        int i_size = std::min(16, (int)TypeParam::d(0));
+        int j_size = std::min(2, (int)TypeParam::d(1));
+        int k_size = TypeParam::d(2);
+        auto builder = storage::builder<typename TypeParam::storage_traits_t>.dimensions(i_size, j_size, k_size);
+        auto in_storage = builder.template type<float_t const>().initializer(in).build();
+        auto out = builder.template type<float_t>().build();
+        auto grid = make_grid(i_size, j_size, k_size);
+
+        run(get_spec<TypeParam>(), TypeParam::backend(), grid, in_storage, out);
+        TypeParam::verify(expected, out);
+        TypeParam::benchmark("kserial_chain_small_ij",
+            [&] { run(get_spec<TypeParam>(), TypeParam::backend(), grid, in_storage, out); });
+
+#ifdef GT_STENCIL_CPU_IFIRST
+        {
+            using pipelined_backend_t = cpu_ifirst<thread_pool::omp, std::true_type>;
+            auto pipelined = builder.template type<float_t>().build();
+            run(get_spec<TypeParam>(), pipelined_backend_t(), grid, in_storage, pipelined);
+            TypeParam::verify(expected, pipelined);
+            TypeParam::benchmark("kserial_chain_small_ij_pipelined",
+                [&] { run(get_spec<TypeParam>(), pipelined_backend_t(), grid, in_storage, pipelined); });
+        }
+#endif
+    }
+} // namespace
@@ -0,0 +1,216 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <gridtools/stencil/cartesian.hpp>
+
+#include <stencil_select.hpp>
+#include <test_environment.hpp>
+
+#include "horizontal_diffusion_repository.hpp"
+
+// Prepared computations must give the same results as `run` in every call. The benchmarks compare the time per call
+// of `run` and of the prepared computation, on a tiny domain the difference is the setup overhead of `run`.
+namespace {
+    using namespace gridtools;
+    using namespace stencil;
+    using namespace cartesian;
+
+    using full_t = axis<1>::full_interval;
+
+    struct copy_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1>;
+
+        using param_list = make_param_list<out, in>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) = eval(in());
+        }
+    };
+
+    struct lap_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+        using param_list = make_param_list<out, in>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) = 4 * eval(in()) - (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) + eval(in(0, -1)));
+        }
+    };
+
+    struct flx_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<0, 1, 0, 0>>;
+        using lap = in_accessor<2, extent<0, 1, 0, 0>>;
+
+        using param_list = make_param_list<out, in, lap>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            auto res = eval(lap(1, 0)) - eval(lap(0, 0));
+            eval(out()) = res * (eval(in(1, 0)) - eval(in(0, 0))) > 0 ? 0 : res;
+        }
+    };
+
+    struct fly_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<0, 0, 0, 1>>;
+        using lap = in_accessor<2, extent<0, 0, 0, 1>>;
+
+        using param_list = make_param_list<out, in, lap>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            auto res = eval(lap(0, 1)) - eval(lap(0, 0));
+            eval(out()) = res * (eval(in(0, 1)) - eval(in(0, 0))) > 0 ? 0 : res;
+        }
+    };
+
+    struct out_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1>;
+        using flx = in_accessor<2, extent<-1, 0, 0, 0>>;
+        using fly = in_accessor<3, extent<0, 0, -1, 0>>;
+        using coeff = in_accessor<4>;
+
+        using param_list = make_param_list<out, in, flx, fly, coeff>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) =
+                eval(in()) - eval(coeff()) * (eval(flx()) - eval(flx(-1, 0)) + eval(fly()) - eval(fly(0, -1)));
+        }
+    };
+
+    // accumulates `in` along k, the running sum is kept in a k-cached temporary
+    struct prefix_sum_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1>;
+        using sum = inout_accessor<2, extent<0, 0, 0, 0, -1, 0>>;
+
+        using param_list = make_param_list<out, in, sum>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval, full_t::first_level) {
+            eval(sum()) = eval(in());
+            eval(out()) = eval(sum());
+        }
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval, full_t::modify<1, 0>) {
+            eval(sum()) = eval(sum(0, 0, -1)) + eval(in());
+            eval(out()) = eval(sum());
+        }
+    };
+
+    template <class Env,
+        std::enable_if_t<
+            !meta::is_instantiation_of<gpu_horizontal_backend::gpu_horizontal, typename Env::backend_t>::value,
+            int> = 0>
+    auto get_spec() {
+        return [](auto in, auto coeff, auto out) {
+            GT_DECLARE_TMP(typename Env::float_t, lap, flx, fly);
+            return execute_parallel()
+                .ij_cached(lap, flx, fly)
+                .stage(lap_function(), lap, in)
+                .stage(flx_function(), flx, in, lap)
+                .stage(fly_function(), fly, in, lap)
+                .stage(out_function(), out, in, flx, fly, coeff);
+        };
+    }
+
+    template <class Env,
+        std::enable_if_t<
+            meta::is_instantiation_of<gpu_horizontal_backend::gpu_horizontal, typename Env::backend_t>::value,
+            int> = 0>
+    auto get_spec() {
+        return [](auto in, auto coeff, auto out) {
+            GT_DECLARE_TMP(typename Env::float_t, inc, lap, flx, fly);
+            return execute_parallel()
+                .stage(copy_function(), inc, in)
+                .stage(lap_function(), lap, inc)
+                .stage(flx_function(), flx, inc, lap)
+                .stage(fly_function(), fly, inc, lap)
+                .stage(out_function(), out, inc, flx, fly, coeff);
+        };
+    }
+
+    template <class Env>
+    auto get_prefix_sum_spec() {
+        return [](auto in, auto out) {
+            GT_DECLARE_TMP(typename Env::float_t, sum);
+            return execute_forward().k_cached(sum).stage(prefix_sum_function(), out, in, sum);
+        };
+    }
+
+    GT_REGRESSION_TEST(prepared_run, test_environment<2>, stencil_backend_t) {
+        using float_t = typename TypeParam::float_t;
+        horizontal_diffusion_repository repo(TypeParam::d(0), TypeParam::d(1), TypeParam::d(2));
+        auto grid = TypeParam::make_grid();
+        auto in = TypeParam::make_const_storage(repo.in);
+        auto coeff = TypeParam::make_const_storage(repo.coeff);
+        auto out = TypeParam::make_storage();
+
+        auto diffusion = prepare(get_spec<TypeParam>(), TypeParam::backend(), grid, in, coeff, out);
+        for (int i = 0; i != 3; ++i) {
+            diffusion();
+            TypeParam::verify(repo.out, out);
+        }
+        TypeParam::benchmark("horizontal_diffusion_run",
+            [&] { run(get_spec<TypeParam>(), TypeParam::backend(), grid, in, coeff, out); });
+        TypeParam::benchmark("horizontal_diffusion_prepared", diffusion);
+
+        // the prepared computation must not depend on the arguments that were passed to `prepare`
+        auto sum = [&] {
+            auto tmp = TypeParam::make_storage([](int i, int j, int k) { return i + j + k; });
+            return prepare(get_prefix_sum_spec<TypeParam>(), TypeParam::backend(), TypeParam::make_grid(), tmp, out);
+        }();
+        sum();
+        sum();
+        TypeParam::verify(
+            [](int i, int j, int k) { return float_t((k + 1) * (i + j) + k * (k + 1) / 2); }, out);
+
+        // per call overhead on a tiny domain
+        auto tiny = make_grid(std::min(4, (int)TypeParam::d(0)), std::min(4, (int)TypeParam::d(1)), 1);
+        auto copy_spec = [](auto in, auto out) { return execute_parallel().stage(copy_function(), out, in); };
+        auto copy = prepare(copy_spec, TypeParam::backend(), tiny, in, out);
+        copy();
+        TypeParam::benchmark("copy_stencil_tiny_run", [&] {
+            for (int i = 0; i != 1000; ++i)
+                run(copy_spec, TypeParam::backend(), tiny, in, out);
+        });
+        TypeParam::benchmark("copy_stencil_tiny_prepared", [&] {
+            for (int i = 0; i != 1000; ++i)
+                copy();
+        });
+        auto view = out->const_host_view();
+        auto expected = in->const_host_view();
+        EXPECT_EQ(view(0, 0, 0), expected(0, 0, 0));
+        EXPECT_EQ(view(3, 3, 0), expected(3, 3, 0));
+
+#if defined(_OPENMP) && (defined(GT_STENCIL_CPU_KFIRST) || defined(GT_STENCIL_CPU_IFIRST))
+        // the temporaries are sized for the threads that were available at preparation
+        int threads = omp_get_max_threads();
+        omp_set_num_threads(threads + 1);
+        EXPECT_THROW(diffusion(), std::runtime_error);
+        omp_set_num_threads(threads);
+        diffusion();
+        TypeParam::verify(repo.out, out);
+#endif
+    }
+} // namespace
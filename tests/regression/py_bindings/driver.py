@@ -1,5 +1,6 @@
 import os
 import sys
+import timeit
 
 sys.path.append(os.getcwd())
 
@@ -33,6 +34,47 @@ def test_scalar():
     testee.copy_from_scalar(42., dst)
     assert np.all(dst == 42.)
 
+def test_3d_without_gil():
+    src = np.fromfunction(lambda i, j, k : i + j + k, (3, 4, 5), dtype=np.double)
+    dst = np.zeros_like(src)
+    testee.copy_from_3D_without_gil(src, dst)
+    assert np.all(dst == src)
+
+def test_3d_cached():
+    src = np.fromfunction(lambda i, j, k : i + j + k, (3, 4, 5), dtype=np.double)
+    dst = np.zeros_like(src)
+    assert testee.copy_from_3D_cached(src, dst) == 2
+    assert np.all(dst == src)
+    src += 1
+    assert testee.copy_from_3D_cached(src, dst) == 2
+    assert np.all(dst == src)
+    other = np.zeros_like(src)
+    assert testee.copy_from_3D_cached(src, other) == 3
+    assert np.all(other == src)
+
+def test_3d_cached_changed_in_place():
+    src = np.fromfunction(lambda i, j, k : i + j + k, (3, 4, 5), dtype=np.double)
+    dst = np.zeros_like(src)
+    testee.copy_from_3D_cached(src, dst)
+    # numpy allows to change the shape and the dtype of an array in place, the cached SIDs must not be reused then
+    src.shape = (5, 4, 3)
+    dst = np.zeros_like(src)
+    testee.copy_from_3D_cached(src, dst)
+    assert np.all(dst == src)
+    dst.dtype = np.int64
+    try:
+        testee.copy_from_3D_cached(src, dst)
+        assert False, "the cached SID of an array with a changed dtype was used"
+    except ValueError:
+        pass
+
+def test_3d_batch():
+    srcs = [np.full((3, 4, 5), i, dtype=np.double) for i in range(4)]
+    dsts = [np.zeros((3, 4, 5), dtype=np.double) for _ in range(4)]
+    testee.copy_from_3D_batch(srcs, dsts)
+    for src, dst in zip(srcs, dsts):
+        assert np.all(dst == src)
+
 def test_cuda_sid():
     class Mock:
         def __init__(self, **kwargs):
@@ -62,9 +104,36 @@ def test_cuda_sid():
         data=(0xDEADBEAF, True),
         version=2)
     testee.check_cuda_sid(mock, 0xDEADBEAF, (4 * 5, 5, 1), (3, 4, 5))
+    testee.check_cached_cuda_sid(mock, 0xDEADBEAF, (4 * 5, 5, 1), (3, 4, 5))
+    testee.check_cached_cuda_sid(mock, 0xDEADBEAF, (4 * 5, 5, 1), (3, 4, 5))
+    mock.kwargs["shape"] = (5, 4, 3)
+    testee.check_cached_cuda_sid(mock, 0xDEADBEAF, (4 * 3, 3, 1), (5, 4, 3))
+
+# Prints the time per python call of the copy of a small domain, where the SID conversion dominates. Only run if the
+# GT_PY_BINDINGS_BENCHMARK environment variable is set, as it takes much longer than the tests.
+def benchmark_call_overhead(calls=10000):
+    src = np.ones((4, 4, 4), dtype=np.double)
+    dst = np.zeros_like(src)
+    srcs = [src] * 16
+    dsts = [dst] * 16
+    for name, fun in [
+            ("copy_from_3D", lambda: testee.copy_from_3D(src, dst)),
+            ("copy_from_3D_without_gil", lambda: testee.copy_from_3D_without_gil(src, dst)),
+            ("copy_from_3D_cached", lambda: testee.copy_from_3D_cached(src, dst)),
+            ("copy_from_3D_batch / 16", lambda: testee.copy_from_3D_batch(srcs, dsts))]:
+        seconds = min(timeit.repeat(fun, number=calls, repeat=3)) / calls
+        if name.endswith("/ 16"):
+            seconds /= 16
+        print("{:<28}{:8.3f} us per copy".format(name, seconds * 1e6))
 
 test_3d()
 test_3d_with_unit_stride()
 test_1d()
 test_scalar()
+test_3d_without_gil()
+test_3d_cached()
+test_3d_cached_changed_in_place()
+test_3d_batch()
 test_cuda_sid()
+if os.environ.get("GT_PY_BINDINGS_BENCHMARK"):
+    benchmark_call_overhead()
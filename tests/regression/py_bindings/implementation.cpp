@@ -12,6 +12,8 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <memory>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -109,10 +111,46 @@ PYBIND11_MODULE(py_implementation, m) {
         "copy_from_scalar",
         [](double from, py::buffer to) { copy(global_parameter(from), as_sid<double, 3>(to)); },
         "Copy from the scalar to a 3D buffer of doubles.");
+    m.def(
+        "copy_from_3D_without_gil",
+        [](py::buffer from, py::buffer to) {
+            auto src = as_sid<double const, 3>(from);
+            auto dst = as_sid<double, 3>(to);
+            without_gil([&] { copy(src, dst); });
+        },
+        "Copy from one 3D buffer of doubles to another, the GIL is released during the copy.");
+    m.def(
+        "copy_from_3D_cached",
+        [src_cache = std::make_shared<sid_cache<double const, 3>>(),
+            dst_cache = std::make_shared<sid_cache<double, 3>>()](py::buffer from, py::buffer to) {
+            copy((*src_cache)(from), (*dst_cache)(to));
+            return src_cache->size() + dst_cache->size();
+        },
+        "Copy from one 3D buffer of doubles to another, the SIDs are cached between calls. Returns the cache size.");
+    m.def(
+        "copy_from_3D_batch",
+        [](py::sequence from, py::sequence to) {
+            auto srcs = as_sids<double const, 3>(from);
+            auto dsts = as_sids<double, 3>(to);
+            if (srcs.size() != dsts.size())
+                throw std::domain_error("sequences of different size");
+            without_gil([&] {
+                for (size_t i = 0; i != srcs.size(); ++i)
+                    copy(srcs[i], dsts[i]);
+            });
+        },
+        "Copy pairwise from a sequence of 3D buffers of doubles to another.");
     m.def(
         "check_cuda_sid",
         [](py::object testeee, size_t ptr, std::vector<size_t> const &strides, std::vector<size_t> const &dims) {
             check_cuda_sid(as_cuda_sid<double const, 3>(testeee), ptr, strides, dims);
         },
         "Check CUDA Sid.");
+    m.def(
+        "check_cached_cuda_sid",
+        [cache = std::make_shared<cuda_sid_cache<double const, 3>>(1)](
+            py::object testeee, size_t ptr, std::vector<size_t> const &strides, std::vector<size_t> const &dims) {
+            check_cuda_sid((*cache)(testeee), ptr, strides, dims);
+        },
+        "Check CUDA Sid, going through a cache of one entry.");
 }
@@ -0,0 +1,214 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/common/float16.hpp>
+#include <gridtools/sid/convert.hpp>
+#include <gridtools/stencil/cartesian.hpp>
+
+#include <stencil_select.hpp>
+#include <test_environment.hpp>
+
+#include "horizontal_diffusion_repository.hpp"
+
+// Copy stencil and horizontal diffusion with the large input fields stored in reduced precision and converted to
+// the compute type on load. The results are verified against a reference that is computed from the rounded inputs,
+// the deviation from the full precision reference is reported as the `<stencil>_<storage>_max_error` test property.
+namespace {
+    using namespace gridtools;
+    using namespace stencil;
+    using namespace cartesian;
+
+    struct copy_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1>;
+
+        using param_list = make_param_list<out, in>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) = eval(in());
+        }
+    };
+
+    struct lap_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+
+        using param_list = make_param_list<out, in>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            using float_t = std::decay_t<decltype(eval(out()))>;
+            eval(out()) =
+                float_t{4} * eval(in()) - (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) + eval(in(0, -1)));
+        }
+    };
+
+    struct flx_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<0, 1, 0, 0>>;
+        using lap = in_accessor<2, extent<0, 1, 0, 0>>;
+
+        using param_list = make_param_list<out, in, lap>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            auto res = eval(lap(1, 0)) - eval(lap(0, 0));
+            eval(out()) = res * (eval(in(1, 0)) - eval(in(0, 0))) > 0 ? 0 : res;
+        }
+    };
+
+    struct fly_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<0, 0, 0, 1>>;
+        using lap = in_accessor<2, extent<0, 0, 0, 1>>;
+
+        using param_list = make_param_list<out, in, lap>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            auto res = eval(lap(0, 1)) - eval(lap(0, 0));
+            eval(out()) = res * (eval(in(0, 1)) - eval(in(0, 0))) > 0 ? 0 : res;
+        }
+    };
+
+    struct out_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1>;
+        using flx = in_accessor<2, extent<-1, 0, 0, 0>>;
+        using fly = in_accessor<3, extent<0, 0, -1, 0>>;
+        using coeff = in_accessor<4>;
+
+        using param_list = make_param_list<out, in, flx, fly, coeff>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) =
+                eval(in()) - eval(coeff()) * (eval(flx()) - eval(flx(-1, 0)) + eval(fly()) - eval(fly(0, -1)));
+        }
+    };
+
+    template <class Env,
+        std::enable_if_t<
+            !meta::is_instantiation_of<gpu_horizontal_backend::gpu_horizontal, typename Env::backend_t>::value,
+            int> = 0>
+    auto get_spec() {
+        return [](auto in, auto coeff, auto out) {
+            GT_DECLARE_TMP(typename Env::float_t, lap, flx, fly);
+            return execute_parallel()
+                .ij_cached(lap, flx, fly)
+                .stage(lap_function(), lap, in)
+                .stage(flx_function(), flx, in, lap)
+                .stage(fly_function(), fly, in, lap)
+                .stage(out_function(), out, in, flx, fly, coeff);
+        };
+    }
+
+    template <class Env,
+        std::enable_if_t<
+            meta::is_instantiation_of<gpu_horizontal_backend::gpu_horizontal, typename Env::backend_t>::value,
+            int> = 0>
+    auto get_spec() {
+        return [](auto in, auto coeff, auto out) {
+            GT_DECLARE_TMP(typename Env::float_t, inc, lap, flx, fly);
+            return execute_parallel()
+                .stage(copy_function(), inc, in)
+                .stage(lap_function(), lap, inc)
+                .stage(flx_function(), flx, inc, lap)
+                .stage(fly_function(), fly, inc, lap)
+                .stage(out_function(), out, inc, flx, fly, coeff);
+        };
+    }
+
+    template <class Storage>
+    std::string storage_name() {
+        return std::is_same_v<Storage, float> ? "float" : std::is_same_v<Storage, float16_t> ? "float16" : "bfloat16";
+    }
+
+    // rounds the values of `fun` to `Storage`
+    template <class Compute, class Storage, class Fun>
+    auto rounded(Fun fun) {
+        return [fun](int i, int j, int k) { return static_cast<Compute>(static_cast<Storage>(fun(i, j, k))); };
+    }
+
+    template <class Env, class Fun, class DataStore>
+    double max_error(Fun const &fun, DataStore const &ds, int halo) {
+        double res = 0;
+        auto view = ds->const_host_view();
+        auto &&lengths = ds->lengths();
+        for (int i = halo; i < (int)lengths[0] - halo; ++i)
+            for (int j = halo; j < (int)lengths[1] - halo; ++j)
+                for (int k = 0; k < (int)lengths[2]; ++k)
+                    res = std::max(res, std::abs(double(view(i, j, k)) - fun(i, j, k)));
+        return res;
+    }
+
+    template <class Env, class Storage>
+    void copy_stencil() {
+        using float_t = typename Env::float_t;
+        auto fun = [](int i, int j, int k) { return 1 + .1 * i + .01 * j + .001 * k; };
+        auto in = Env::template make_const_storage<Storage>(fun);
+        auto out = Env::template make_storage<Storage>();
+        auto comp = [&, grid = Env::make_grid()] {
+            run_single_stage(copy_function(),
+                Env::backend(),
+                grid,
+                sid::convert<float_t>(out),
+                sid::convert<float_t>(in));
+        };
+        comp();
+        Env::verify(fun, out);
+        testing::Test::RecordProperty(
+            "copy_stencil_" + storage_name<Storage>() + "_max_error", std::to_string(max_error<Env>(fun, out, 2)));
+        Env::benchmark("copy_stencil_" + storage_name<Storage>(), comp);
+    }
+
+    template <class Env, class Storage>
+    void horizontal_diffusion() {
+        using float_t = typename Env::float_t;
+        horizontal_diffusion_repository repo(Env::d(0), Env::d(1), Env::d(2));
+        auto out = Env::make_storage();
+        auto comp = [&,
+                        grid = Env::make_grid(),
+                        coeff = Env::template make_const_storage<Storage>(repo.coeff),
+                        in = Env::template make_const_storage<Storage>(repo.in)] {
+            run(get_spec<Env>(), Env::backend(), grid, sid::convert<float_t>(in), sid::convert<float_t>(coeff), out);
+        };
+        comp();
+
+        horizontal_diffusion_repository rounded_repo(Env::d(0), Env::d(1), Env::d(2));
+        rounded_repo.in = rounded<float_t, Storage>(repo.in);
+        rounded_repo.coeff = rounded<float_t, Storage>(repo.coeff);
+        Env::verify(rounded_repo.out, out, [](float_t lhs, float_t rhs) {
+            return expect_with_threshold(lhs, rhs, std::is_same_v<float_t, float> ? 1e-5 : 1e-12);
+        });
+        testing::Test::RecordProperty("horizontal_diffusion_" + storage_name<Storage>() + "_max_error",
+            std::to_string(max_error<Env>(repo.out, out, 2)));
+        Env::benchmark("horizontal_diffusion_" + storage_name<Storage>(), comp);
+    }
+
+    GT_REGRESSION_TEST(reduced_precision, test_environment<2>, stencil_backend_t) {
+        if constexpr (std::is_same_v<typename TypeParam::float_t, double>) {
+            copy_stencil<TypeParam, float>();
+            horizontal_diffusion<TypeParam, float>();
+        }
+        copy_stencil<TypeParam, float16_t>();
+        horizontal_diffusion<TypeParam, float16_t>();
+        copy_stencil<TypeParam, bfloat16_t>();
+        horizontal_diffusion<TypeParam, bfloat16_t>();
+    }
+} // namespace
@@ -0,0 +1,143 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <string>
+#include <utility>
+
+#include <gridtools/stencil/cartesian.hpp>
+
+#include <stencil_select.hpp>
+#include <test_environment.hpp>
+
+#include "horizontal_diffusion_repository.hpp"
+
+namespace {
+    using namespace gridtools;
+    using namespace stencil;
+    using namespace cartesian;
+
+    struct lap_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+        using param_list = make_param_list<out, in>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) = 4 * eval(in()) - (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) + eval(in(0, -1)));
+        }
+    };
+
+    struct flx_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<0, 1, 0, 0>>;
+        using lap = in_accessor<2, extent<0, 1, 0, 0>>;
+
+        using param_list = make_param_list<out, in, lap>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            auto res = eval(lap(1, 0)) - eval(lap(0, 0));
+            eval(out()) = res * (eval(in(1, 0)) - eval(in(0, 0))) > 0 ? 0 : res;
+        }
+    };
+
+    struct fly_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1, extent<0, 0, 0, 1>>;
+        using lap = in_accessor<2, extent<0, 0, 0, 1>>;
+
+        using param_list = make_param_list<out, in, lap>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            auto res = eval(lap(0, 1)) - eval(lap(0, 0));
+            eval(out()) = res * (eval(in(0, 1)) - eval(in(0, 0))) > 0 ? 0 : res;
+        }
+    };
+
+    struct out_function {
+        using out = inout_accessor<0>;
+        using in = in_accessor<1>;
+        using flx = in_accessor<2, extent<-1, 0, 0, 0>>;
+        using fly = in_accessor<3, extent<0, 0, -1, 0>>;
+        using coeff = in_accessor<4>;
+
+        using param_list = make_param_list<out, in, flx, fly, coeff>;
+
+        template <typename Evaluation>
+        GT_FUNCTION static void apply(Evaluation eval) {
+            eval(out()) =
+                eval(in()) - eval(coeff()) * (eval(flx()) - eval(flx(-1, 0)) + eval(fly()) - eval(fly(0, -1)));
+        }
+    };
+
+    const auto laplacian_spec = [](auto in, auto out) { return execute_parallel().stage(lap_function(), out, in); };
+
+    template <class Env>
+    auto horizontal_diffusion_spec() {
+        return [](auto in, auto out, auto coeff) {
+            GT_DECLARE_TMP(typename Env::float_t, lap, flx, fly);
+            return execute_parallel()
+                .ij_cached(lap, flx, fly)
+                .stage(lap_function(), lap, in)
+                .stage(flx_function(), flx, in, lap)
+                .stage(fly_function(), fly, in, lap)
+                .stage(out_function(), out, in, flx, fly, coeff);
+        };
+    }
+
+    // the time steps one after the other, the result is returned in `in`
+    template <class Env, class Spec, class Storage, class... Fields>
+    void run_unblocked(Spec spec, int_t steps, Storage &in, Storage &out, Fields const &...fields) {
+        for (int_t step = 0; step != steps; ++step) {
+            run(spec, Env::backend(), Env::make_grid(), in, out, fields...);
+            std::swap(in, out);
+        }
+    }
+
+    template <class Env, class Init, class Spec, class... Fields>
+    void test_time_steps(std::string const &name, Init const &init, Spec spec, Fields const &...fields) {
+        for (int_t steps : {1, 2, 3, 4, 8, 16}) {
+            auto in = Env::make_const_storage(init);
+            auto out = Env::make_storage();
+            run_time_steps(spec, Env::backend(), Env::make_grid(), time_steps{steps, 8, 8}, in, out, fields...);
+
+            auto expected = Env::make_storage(init);
+            auto tmp = Env::make_storage(init);
+            run_unblocked<Env>(spec, steps, expected, tmp, fields...);
+            Env::verify(expected, out);
+        }
+        for (int_t steps : {1, 2, 4, 8, 16}) {
+            auto in = Env::make_const_storage(init);
+            auto out = Env::make_storage();
+            Env::benchmark(name + "_blocked_" + std::to_string(steps), [&] {
+                run_time_steps(spec, Env::backend(), Env::make_grid(), time_steps{steps}, in, out, fields...);
+            });
+            auto a = Env::make_storage(init);
+            auto b = Env::make_storage(init);
+            Env::benchmark(name + "_unblocked_" + std::to_string(steps),
+                [&] { run_unblocked<Env>(spec, steps, a, b, fields...); });
+        }
+    }
+
+#if !defined(GT_STENCIL_GPU) && !defined(GT_STENCIL_GPU_HORIZONTAL)
+    GT_REGRESSION_TEST(temporal_blocking_laplacian, test_environment<1>, stencil_backend_t) {
+        auto in = [](int_t i, int_t j, int_t k) { return i % 5 - j % 3 + .5 * k; };
+        test_time_steps<TypeParam>("temporal_blocking_laplacian", in, laplacian_spec);
+    }
+
+    GT_REGRESSION_TEST(temporal_blocking_horizontal_diffusion, test_environment<2>, stencil_backend_t) {
+        horizontal_diffusion_repository repo(TypeParam::d(0), TypeParam::d(1), TypeParam::d(2));
+        test_time_steps<TypeParam>("temporal_blocking_horizontal_diffusion",
+            repo.in,
+            horizontal_diffusion_spec<TypeParam>(),
+            TypeParam::make_const_storage(repo.coeff));
+    }
+#endif
+} // namespace
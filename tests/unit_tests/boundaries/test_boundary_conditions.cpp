@@ -12,6 +12,7 @@
 
 #include <gridtools/boundaries/boundary.hpp>
 #include <gridtools/boundaries/copy.hpp>
+#include <gridtools/boundaries/fused_apply.hpp>
 #include <gridtools/boundaries/value.hpp>
 #include <gridtools/boundaries/zero.hpp>
 #include <gridtools/common/halo_descriptor.hpp>
@@ -889,3 +890,42 @@ TEST(boundaryconditions, basic) { EXPECT_EQ(basic(), true); }
 TEST(boundaryconditions, usingvalue2) { EXPECT_EQ(usingvalue_2(), true); }
 
 TEST(boundaryconditions, usingcopy3) { EXPECT_EQ(usingcopy_3(), true); }
+
+#ifndef GT_STORAGE_GPU
+TEST(boundaryconditions, fused) {
+    uint_t d1 = 6;
+    uint_t d2 = 5;
+    uint_t d3 = 7;
+
+    array<halo_descriptor, 3> halos;
+    halos[0] = halo_descriptor(2, 1, 2, d1 - 2, d1);
+    halos[1] = halo_descriptor(1, 2, 1, d2 - 3, d2);
+    halos[2] = halo_descriptor(3, 1, 3, d3 - 2, d3);
+
+    auto init = [](int i, int j, int k) { return 100 * i + 10 * j + k; };
+    auto src = storage::builder<storage_traits_t>.type<int_t>().dimensions(d1, d2, d3).initializer(init)();
+    auto expected0 = make_storage(d1, d2, d3, -1);
+    auto expected1 = make_storage(d1, d2, d3, -1);
+    auto actual0 = make_storage(d1, d2, d3, -1);
+    auto actual1 = make_storage(d1, d2, d3, -1);
+
+    boundary_apply<bc_two, minus_predicate>(halos, bc_two(), minus_predicate()).apply(expected0->target_view());
+    boundary_apply<copy_boundary, minus_predicate>(halos, copy_boundary(), minus_predicate())
+        .apply(expected1->target_view(), src->const_target_view());
+
+    fused_boundary_apply<minus_predicate>(halos, minus_predicate())
+        .apply(make_boundary_job(bc_two(), actual0->target_view()),
+            make_boundary_job(copy_boundary(), actual1->target_view(), src->const_target_view()));
+
+    auto expected0_v = expected0->const_host_view();
+    auto expected1_v = expected1->const_host_view();
+    auto actual0_v = actual0->const_host_view();
+    auto actual1_v = actual1->const_host_view();
+    for (uint_t i = 0; i < d1; ++i)
+        for (uint_t j = 0; j < d2; ++j)
+            for (uint_t k = 0; k < d3; ++k) {
+                EXPECT_EQ(actual0_v(i, j, k), expected0_v(i, j, k));
+                EXPECT_EQ(actual1_v(i, j, k), expected1_v(i, j, k));
+            }
+}
+#endif
@@ -0,0 +1,81 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/boundaries/deep_halo.hpp>
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil/common/extent.hpp>
+
+namespace gridtools {
+    namespace boundaries {
+        namespace {
+            // halo of 3 in i and of 6 in j around a 10x20 domain
+            const array<halo_descriptor, 3> halos = {
+                {{3, 3, 3, 12, 16}, {6, 6, 6, 25, 32}, {0, 0, 0, 4, 5}}};
+
+            void expect_eq(halo_descriptor const &actual, halo_descriptor const &expected) {
+                EXPECT_EQ(actual.minus(), expected.minus());
+                EXPECT_EQ(actual.plus(), expected.plus());
+                EXPECT_EQ(actual.begin(), expected.begin());
+                EXPECT_EQ(actual.end(), expected.end());
+                EXPECT_EQ(actual.total_length(), expected.total_length());
+            }
+
+            TEST(deep_halo_schedule, cadence) {
+                deep_halo_schedule testee(halos, 3);
+                EXPECT_EQ(testee.cadence(), 3);
+                for (int cycle = 0; cycle != 2; ++cycle) {
+                    EXPECT_TRUE(testee.next_step());
+                    EXPECT_EQ(testee.position(), 0);
+                    EXPECT_FALSE(testee.next_step());
+                    EXPECT_FALSE(testee.next_step());
+                    EXPECT_EQ(testee.position(), 2);
+                }
+            }
+
+            TEST(deep_halo_schedule, every_step) {
+                deep_halo_schedule testee(halos);
+                EXPECT_TRUE(testee.next_step());
+                EXPECT_TRUE(testee.next_step());
+                auto res = testee.compute_halos(stencil::extent<-1, 1, -2, 2>());
+                for (int d = 0; d != 3; ++d)
+                    expect_eq(res[d], halos[d]);
+            }
+
+            TEST(deep_halo_schedule, shrinking_domain) {
+                deep_halo_schedule testee(halos, 3);
+                stencil::extent<-1, 0, -2, 1> extent;
+
+                testee.next_step();
+                auto res = testee.compute_halos(extent);
+                expect_eq(res[0], {1, 3, 1, 12, 16});
+                expect_eq(res[1], {2, 4, 2, 27, 32});
+                expect_eq(res[2], halos[2]);
+
+                testee.next_step();
+                res = testee.compute_halos(extent);
+                expect_eq(res[0], {2, 3, 2, 12, 16});
+                expect_eq(res[1], {4, 5, 4, 26, 32});
+
+                testee.next_step();
+                res = testee.compute_halos(extent);
+                expect_eq(res[0], halos[0]);
+                expect_eq(res[1], halos[1]);
+            }
+
+            TEST(deep_halo_schedule, too_thin) {
+                EXPECT_THROW(deep_halo_schedule(halos, 4).compute_halos(stencil::extent<-1, 1>()), std::runtime_error);
+                EXPECT_THROW(deep_halo_schedule(halos, 0), std::invalid_argument);
+            }
+        } // namespace
+    }     // namespace boundaries
+} // namespace gridtools
@@ -161,3 +161,16 @@ TEST_F(distributed_boundaries_test, exchange) {
     expect_b([&](int i, int j, int k) { return from_abroad(i, j) ? c_init(i, j, k) : b_init(i, j, k); });
     expect_d([&](int i, int j, int k) { return from_abroad(i, j) ? triplet{} : d_init(i, j, k); });
 }
+
+TEST_F(distributed_boundaries_test, fused_boundary_only) {
+    testee.fuse_boundaries(true);
+    testee.boundary_only(
+        bind_bc(value_boundary<triplet>(triplet{42, 42, 42}), a), bind_bc(copy_boundary(), b, _1).associate(c), d);
+    expect_a([&](int i, int j, int k) {
+        return from_core(i, j) ? a_init(i, j, k) : from_abroad(i, j) ? triplet{42, 42, 42} : triplet{};
+    });
+    expect_b([&](int i, int j, int k) {
+        return from_core(i, j) ? b_init(i, j, k) : from_abroad(i, j) ? c_init(i, j, k) : triplet{};
+    });
+    expect_d([&](int i, int j, int k) { return from_core(i, j) ? d_init(i, j, k) : triplet{}; });
+}
@@ -0,0 +1,81 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/common/float16.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+namespace gridtools {
+    namespace {
+        TEST(float16, exact_values) {
+            for (float val : {0.f, -0.f, 1.f, -2.f, .5f, 1024.f, 65504.f, 1.f / 1024})
+                EXPECT_EQ(float(float16_t(val)), val);
+            EXPECT_EQ(float16_t(1.).bits(), 0x3c00);
+            EXPECT_EQ(float16_t(-2).bits(), 0xc000);
+            EXPECT_EQ(float16_t(65504.f).bits(), 0x7bff);
+            // smallest subnormal
+            EXPECT_EQ(float16_t(std::ldexp(1.f, -24)).bits(), 0x0001);
+            EXPECT_EQ(float(float16_t::from_bits(0x0001)), std::ldexp(1.f, -24));
+            EXPECT_EQ(float(float16_t::from_bits(0x03ff)), std::ldexp(1023.f, -24));
+        }
+
+        TEST(float16, rounding) {
+            // ties are rounded to even
+            EXPECT_EQ(float16_t(1 + std::ldexp(1.f, -11)).bits(), 0x3c00);
+            EXPECT_EQ(float16_t(1 + 3 * std::ldexp(1.f, -11)).bits(), 0x3c02);
+            EXPECT_EQ(float16_t(1 + std::ldexp(1.f, -10) + std::ldexp(1.f, -12)).bits(), 0x3c01);
+            EXPECT_EQ(float16_t(std::ldexp(1.f, -26)).bits(), 0);
+            EXPECT_EQ(float16_t(std::ldexp(3.f, -26)).bits(), 0x0001);
+        }
+
+        TEST(float16, special_values) {
+            float inf = std::numeric_limits<float>::infinity();
+            EXPECT_EQ(float(float16_t(inf)), inf);
+            EXPECT_EQ(float(float16_t(-inf)), -inf);
+            EXPECT_EQ(float(float16_t(1e6)), inf);
+            EXPECT_EQ(float16_t(65520.f).bits(), 0x7c00);
+            EXPECT_TRUE(std::isnan(float(float16_t(std::nanf("")))));
+        }
+
+        TEST(float16, round_trip) {
+            for (std::uint32_t bits = 0; bits != 0x10000; ++bits) {
+                auto val = float16_t::from_bits(std::uint16_t(bits));
+                if (!std::isnan(float(val))) {
+                    EXPECT_EQ(float16_t(float(val)).bits(), bits);
+                }
+            }
+        }
+
+        TEST(bfloat16, conversions) {
+            for (float val : {0.f, -0.f, 1.f, -2.f, .5f, 3.f, 1e30f, -1e-30f})
+                EXPECT_EQ(float(bfloat16_t(float(bfloat16_t(val)))), float(bfloat16_t(val)));
+            EXPECT_EQ(float(bfloat16_t(1.f)), 1.f);
+            EXPECT_EQ(bfloat16_t(1.).bits(), 0x3f80);
+            EXPECT_EQ(bfloat16_t(1 + std::ldexp(1.f, -8)).bits(), 0x3f80);
+            EXPECT_EQ(bfloat16_t(1 + 3 * std::ldexp(1.f, -8)).bits(), 0x3f82);
+            EXPECT_NEAR(float(bfloat16_t(3.14159)), 3.14159, 3.14159 / 256);
+            EXPECT_TRUE(std::isnan(float(bfloat16_t(std::nanf("")))));
+            float inf = std::numeric_limits<float>::infinity();
+            EXPECT_EQ(float(bfloat16_t(inf)), inf);
+        }
+
+        TEST(bfloat16, round_trip) {
+            for (std::uint32_t bits = 0; bits != 0x10000; ++bits) {
+                auto val = bfloat16_t::from_bits(std::uint16_t(bits));
+                if (!std::isnan(float(val))) {
+                    EXPECT_EQ(bfloat16_t(float(val)).bits(), bits);
+                }
+            }
+        }
+    } // namespace
+} // namespace gridtools
@@ -0,0 +1,108 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/common/memory_accounting.hpp>
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/common/hugepage_alloc.hpp>
+#include <gridtools/sid/allocator.hpp>
+#include <gridtools/storage/builder.hpp>
+#include <gridtools/storage/cpu_ifirst.hpp>
+
+namespace gridtools {
+    namespace memory_accounting {
+        namespace {
+            TEST(memory_accounting, hugepage_alloc) {
+                auto before = get_stats(category::hugepage);
+                void *ptr = hugepage_alloc(1000);
+                auto during = get_stats(category::hugepage);
+                EXPECT_EQ(during.allocations, before.allocations + 1);
+                EXPECT_GE(during.live_bytes, before.live_bytes + 1000);
+                EXPECT_EQ(during.live_bytes - before.live_bytes, during.waste_bytes - before.waste_bytes + 1000);
+                EXPECT_GE(during.peak_bytes, during.live_bytes);
+                hugepage_free(ptr);
+                auto after = get_stats(category::hugepage);
+                EXPECT_EQ(after.live_bytes, before.live_bytes);
+                EXPECT_EQ(after.waste_bytes, before.waste_bytes);
+            }
+
+            TEST(memory_accounting, storage) {
+                auto before = get_stats(category::storage);
+                {
+                    // the rows are padded from 5 to 8 doubles, 8 more doubles are allocated for the alignment
+                    auto ds = storage::builder<storage::cpu_ifirst>.type<double>().dimensions(5, 4, 3).build();
+                    auto during = get_stats(category::storage);
+                    EXPECT_EQ(ds->length(), 8 * 4 * 3 - 3);
+                    EXPECT_EQ(during.live_bytes - before.live_bytes, (ds->length() + 8) * sizeof(double));
+                    EXPECT_EQ(during.live_bytes - during.waste_bytes, before.live_bytes - before.waste_bytes + 60 * 8);
+                }
+                auto after = get_stats(category::storage);
+                EXPECT_EQ(after.live_bytes, before.live_bytes);
+                EXPECT_EQ(after.waste_bytes, before.waste_bytes);
+            }
+
+            TEST(memory_accounting, cached_allocator) {
+                auto temporaries = get_stats(category::temporaries);
+                auto cache = get_stats(category::allocator_cache);
+                {
+                    sid::cached_allocator alloc(&std::make_unique<char[]>);
+                    allocate(alloc, meta::lazy::id<double>(), 100);
+                    EXPECT_EQ(get_stats(category::temporaries).live_bytes, temporaries.live_bytes + 800);
+                }
+                EXPECT_EQ(get_stats(category::temporaries).live_bytes, temporaries.live_bytes);
+                EXPECT_EQ(get_stats(category::allocator_cache).live_bytes, cache.live_bytes + 800);
+                {
+                    sid::cached_allocator alloc(&std::make_unique<char[]>);
+                    allocate(alloc, meta::lazy::id<double>(), 100);
+                    EXPECT_EQ(get_stats(category::allocator_cache).live_bytes, cache.live_bytes);
+                }
+            }
+
+            TEST(memory_accounting, computation_scope) {
+                reset_peaks();
+                for (int i = 0; i != 2; ++i) {
+                    computation_scope outer("outer");
+                    {
+                        computation_scope inner("inner");
+                        sid::allocator alloc(&std::make_unique<char[]>);
+                        allocate(alloc, meta::lazy::id<char>(), 100);
+                        allocate(alloc, meta::lazy::id<char>(), 50);
+                    }
+                    sid::allocator alloc(&std::make_unique<char[]>);
+                    allocate(alloc, meta::lazy::id<char>(), 120);
+                }
+                auto computations = get_computation_stats();
+                ASSERT_EQ(computations.size(), 2);
+                EXPECT_EQ(computations["inner"].calls, 2);
+                EXPECT_EQ(computations["inner"].allocated_bytes, 300);
+                EXPECT_EQ(computations["inner"].peak_bytes, 150);
+                EXPECT_EQ(computations["outer"].calls, 2);
+                EXPECT_EQ(computations["outer"].allocated_bytes, 540);
+                EXPECT_EQ(computations["outer"].peak_bytes, 150);
+            }
+
+            TEST(memory_accounting, json) {
+                {
+                    computation_scope scope("with \"quotes\"");
+                }
+                auto json = to_json();
+                for (auto key : {"\"hugepage\": {\"live_bytes\": ",
+                         "\"storage\": ",
+                         "\"temporaries\": ",
+                         "\"allocator_cache\": ",
+                         "\"computations\": {",
+                         "\"with \\\"quotes\\\"\": {\"calls\": 1"})
+                    EXPECT_NE(json.find(key), std::string::npos) << key << "\n" << json;
+            }
+        } // namespace
+    }     // namespace memory_accounting
+} // namespace gridtools
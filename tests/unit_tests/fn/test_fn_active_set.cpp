@@ -0,0 +1,67 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/fn/active_set.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace gridtools::fn {
+    namespace {
+        using ranges_t = std::vector<active_range>;
+
+        ranges_t chunk(active_set const &set, std::size_t c) {
+            auto [first, last] = set.chunk(c);
+            return {first, last};
+        }
+
+        TEST(active_set, from_mask) {
+            active_set set(5, 2, [](int i, int j) { return j == 0 ? i != 2 : i > 0; });
+            EXPECT_EQ(set.size(), 8);
+            EXPECT_EQ(set.ranges(), (ranges_t{{0, 2, 0}, {3, 5, 0}, {1, 5, 1}}));
+            EXPECT_EQ(set.num_chunks(), 1);
+        }
+
+        TEST(active_set, from_columns) {
+            active_set set(4, 3, std::vector<std::array<int, 2>>{{2, 1}, {0, 2}, {1, 1}, {3, 1}, {2, 1}});
+            EXPECT_EQ(set.size(), 4);
+            EXPECT_EQ(set.ranges(), (ranges_t{{1, 4, 1}, {0, 1, 2}}));
+        }
+
+        TEST(active_set, from_ranges) {
+            active_set set(10, 2, ranges_t{{5, 8, 1}, {0, 3, 1}, {2, 4, 1}, {4, 5, 1}, {6, 6, 0}, {9, 10, 0}});
+            EXPECT_EQ(set.size(), 9);
+            EXPECT_EQ(set.ranges(), (ranges_t{{9, 10, 0}, {0, 8, 1}}));
+        }
+
+        TEST(active_set, chunks) {
+            active_set set(10, 2, ranges_t{{0, 3, 0}, {5, 10, 0}, {2, 9, 1}}, 4);
+            EXPECT_EQ(set.size(), 15);
+            ASSERT_EQ(set.num_chunks(), 4);
+            EXPECT_EQ(chunk(set, 0), (ranges_t{{0, 3, 0}, {5, 6, 0}}));
+            EXPECT_EQ(chunk(set, 1), (ranges_t{{6, 10, 0}}));
+            EXPECT_EQ(chunk(set, 2), (ranges_t{{2, 6, 1}}));
+            EXPECT_EQ(chunk(set, 3), (ranges_t{{6, 9, 1}}));
+        }
+
+        TEST(active_set, dilated) {
+            active_set set(6, 4, ranges_t{{0, 1, 0}, {3, 4, 2}});
+            auto testee = set.dilated(1, 2, 0, 1);
+            EXPECT_EQ(testee.size(), 14);
+            EXPECT_EQ(testee.ranges(), (ranges_t{{0, 3, 0}, {0, 3, 1}, {2, 6, 2}, {2, 6, 3}}));
+        }
+
+        TEST(active_set, empty) {
+            active_set set(3, 3, [](int, int) { return false; });
+            EXPECT_EQ(set.size(), 0);
+            EXPECT_EQ(set.num_chunks(), 0);
+        }
+    } // namespace
+} // namespace gridtools::fn
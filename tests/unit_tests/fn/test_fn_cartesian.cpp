@@ -67,6 +67,37 @@ namespace gridtools::fn {
                         EXPECT_EQ(out[i][j][k], 6 * (i + 2) + 2 * j + k);
         }
 
+        TEST(cartesian, transient) {
+            auto apply_stencils = [](auto &&executor, auto &out, auto const &in) {
+                executor()
+                    .arg(out)
+                    .transient()
+                    .arg(in)
+                    .assign(1_c, stencil(), 2_c)
+                    .assign(0_c, stencil(), 1_c)
+                    .execute();
+            };
+
+            auto fencil = [&](auto const &sizes, auto &out, auto const &in) {
+                auto domain = cartesian_domain(std::array<int, 3>{sizes[0] - 2, sizes[1], sizes[2]});
+                auto backend = make_backend(backend::naive(), domain);
+                apply_stencils(backend.stencil_executor(), out, in);
+            };
+
+            int in[5][3][2], out[5][3][2] = {};
+            for (int i = 0; i < 5; ++i)
+                for (int j = 0; j < 3; ++j)
+                    for (int k = 0; k < 2; ++k)
+                        in[i][j][k] = 6 * i + 2 * j + k;
+
+            fencil(std::array{5, 3, 2}, out, in);
+
+            for (int i = 0; i < 5; ++i)
+                for (int j = 0; j < 3; ++j)
+                    for (int k = 0; k < 2; ++k)
+                        EXPECT_EQ(out[i][j][k], i < 3 ? 6 * (i + 2) + 2 * j + k : 0);
+        }
+
         TEST(cartesian, vertical) {
             auto apply_double_scan = [](auto executor, auto &a, auto &b, auto const &c) {
                 executor()
@@ -107,5 +138,80 @@ namespace gridtools::fn {
                     }
                 }
         }
+
+        TEST(cartesian, active_stencil) {
+            int in[5][3][2], out[5][3][2] = {};
+            for (int i = 0; i < 5; ++i)
+                for (int j = 0; j < 3; ++j)
+                    for (int k = 0; k < 2; ++k)
+                        in[i][j][k] = 6 * i + 2 * j + k;
+
+            auto active = [](int i, int j) { return (i + j) % 3 != 0; };
+            active_set set(4, 3, active, 2);
+            auto domain = cartesian_active_domain(std::array<int, 3>{4, 3, 2}, set);
+            make_backend(backend::naive(), domain)
+                .stencil_executor()()
+                .arg(out)
+                .arg(in)
+                .assign(0_c, stencil(), 1_c)
+                .execute();
+
+            for (int i = 0; i < 5; ++i)
+                for (int j = 0; j < 3; ++j)
+                    for (int k = 0; k < 2; ++k)
+                        EXPECT_EQ(out[i][j][k], i < 4 && active(i, j) ? in[i + 1][j][k] : 0);
+        }
+
+        TEST(cartesian, active_chained_stencils) {
+            int in[5][3][2], tmp[5][3][2] = {}, out[5][3][2] = {};
+            for (int i = 0; i < 5; ++i)
+                for (int j = 0; j < 3; ++j)
+                    for (int k = 0; k < 2; ++k)
+                        in[i][j][k] = 6 * i + 2 * j + k;
+
+            // the second stage reads `tmp` shifted by one in i, so the set is dilated accordingly
+            auto active = [](int i, int j) { return i < 3 && (i + j) % 3 != 0; };
+            auto set = active_set(4, 3, active).dilated(0, 1, 0, 0);
+            auto domain = cartesian_active_domain(std::array<int, 3>{4, 3, 2}, set);
+            make_backend(backend::naive(), domain)
+                .stencil_executor()()
+                .arg(out)
+                .arg(tmp)
+                .arg(in)
+                .assign(1_c, stencil(), 2_c)
+                .assign(0_c, stencil(), 1_c)
+                .execute();
+
+            for (int i = 0; i < 4; ++i)
+                for (int j = 0; j < 3; ++j)
+                    for (int k = 0; k < 2; ++k)
+                        if (active(i, j)) {
+                            EXPECT_EQ(out[i][j][k], in[i + 2][j][k]);
+                        }
+        }
+
+        TEST(cartesian, active_vertical) {
+            int in[5][3][2], out[5][3][2] = {};
+            for (int i = 0; i < 5; ++i)
+                for (int j = 0; j < 3; ++j)
+                    for (int k = 0; k < 2; ++k)
+                        in[i][j][k] = 6 * i + 2 * j + k;
+
+            active_set set(4, 2, std::vector<std::array<int, 2>>{{3, 0}, {0, 1}, {1, 1}, {3, 0}});
+            auto domain = cartesian_active_domain(std::array<int, 3>{4, 2, 2}, set, std::array<int, 3>{1, 1, 0});
+            make_backend(backend::naive(), domain)
+                .vertical_executor()()
+                .arg(out)
+                .arg(in)
+                .assign(0_c, fwd_sum_scan(), 0, 1_c)
+                .execute();
+
+            for (int i = 0; i < 5; ++i)
+                for (int j = 0; j < 3; ++j) {
+                    bool is_active = (i == 4 && j == 1) || (j == 2 && (i == 1 || i == 2));
+                    EXPECT_EQ(out[i][j][0], is_active ? in[i][j][0] : 0);
+                    EXPECT_EQ(out[i][j][1], is_active ? in[i][j][0] + in[i][j][1] : 0);
+                }
+        }
     } // namespace
 } // namespace gridtools::fn
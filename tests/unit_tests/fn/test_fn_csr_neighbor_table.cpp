@@ -0,0 +1,85 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/fn/csr_neighbor_table.hpp>
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/fn/neighbor_table.hpp>
+
+namespace gridtools::fn {
+    namespace {
+
+        using csr_neighbor_table::as_neighbor_table;
+
+        using dim_t = integral_constant<int_t, 0>;
+
+        TEST(csr_neighbor_table, neighbors) {
+            const int offsets[4] = {0, 2, 5, 6};
+            const int indices[6] = {1, 2, 10, 11, 12, 20};
+            const auto table = as_neighbor_table<dim_t, 3>(offsets, indices);
+            static_assert(neighbor_table::is_neighbor_table<std::decay_t<decltype(table)>>());
+
+            EXPECT_EQ(csr_neighbor_table::num_neighbors(table, 0), 2);
+            EXPECT_EQ(csr_neighbor_table::num_neighbors(table, 1), 3);
+            EXPECT_EQ(csr_neighbor_table::num_neighbors(table, 2), 1);
+
+            auto [n00, n01, n02] = neighbor_table::neighbors(table, 0);
+            auto [n10, n11, n12] = neighbor_table::neighbors(table, 1);
+            auto [n20, n21, n22] = neighbor_table::neighbors(table, 2);
+            EXPECT_EQ(n00, 1);
+            EXPECT_EQ(n01, 2);
+            EXPECT_EQ(n02, -1);
+            EXPECT_EQ(n10, 10);
+            EXPECT_EQ(n11, 11);
+            EXPECT_EQ(n12, 12);
+            EXPECT_EQ(n20, 20);
+            EXPECT_EQ(n21, -1);
+            EXPECT_EQ(n22, -1);
+        }
+
+        TEST(csr_neighbor_table, for_each_neighbor) {
+            const int offsets[4] = {0, 2, 5, 6};
+            const int indices[6] = {1, 2, 10, 11, 12, 20};
+            const auto table = as_neighbor_table<dim_t, 3>(offsets, indices);
+
+            // `local_index` is the slot of the neighbor in the padded list
+            auto neighbors = neighbor_table::neighbors(table, 1);
+            int count = 0, sum = 0;
+            neighbor_table::for_each_neighbor(table, 1, [&](int local_index, int neighbor) {
+                EXPECT_EQ(local_index, count);
+                EXPECT_EQ(neighbors[local_index], neighbor);
+                ++count;
+                sum += neighbor;
+            });
+            EXPECT_EQ(count, 3);
+            EXPECT_EQ(sum, 33);
+        }
+
+        TEST(neighbor_table, for_each_neighbor_padded) {
+            std::array<int, 3> table[2] = {{1, -1, 2}, {-1, -1, -1}};
+
+            int count = 0, local_sum = 0, sum = 0;
+            neighbor_table::for_each_neighbor(&table[0], 0, [&](int local_index, int neighbor) {
+                ++count;
+                local_sum += local_index;
+                sum += neighbor;
+            });
+            EXPECT_EQ(count, 2);
+            EXPECT_EQ(local_sum, 2);
+            EXPECT_EQ(sum, 3);
+
+            neighbor_table::for_each_neighbor(&table[0], 1, [&](int, int) { ADD_FAILURE(); });
+        }
+
+    } // namespace
+} // namespace gridtools::fn
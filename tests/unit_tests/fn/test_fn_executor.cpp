@@ -103,5 +103,116 @@ namespace gridtools::fn {
                 }
             }
         }
+
+        TEST(stencil_executor, independent_stages) {
+            using backend_t = backend::naive;
+            auto domain = hymap::keys<int_t<0>, int_t<1>>::make_values(2_c, 3_c);
+
+            int a[2][3] = {}, b[2][3] = {}, c[2][3] = {}, d[2][3];
+            for (int i = 0; i < 2; ++i)
+                for (int j = 0; j < 3; ++j)
+                    d[i][j] = 3 * i + j;
+
+            // the first and the last stage are independent of each other, the second one depends on the first one
+            make_stencil_executor(backend_t(), domain, std::tuple<>(), make_iterator_mock())
+                .arg(a)
+                .arg(b)
+                .arg(c)
+                .arg(d)
+                .merge_independent_stages()
+                .assign(1_c, stencil(), 3_c)
+                .assign(0_c, stencil(), 1_c)
+                .assign(2_c, stencil(), 3_c)
+                .execute();
+
+            for (int i = 0; i < 2; ++i)
+                for (int j = 0; j < 3; ++j) {
+                    EXPECT_EQ(a[i][j], (3 * i + j) * 4);
+                    EXPECT_EQ(b[i][j], (3 * i + j) * 2);
+                    EXPECT_EQ(c[i][j], (3 * i + j) * 2);
+                }
+        }
+
+        TEST(stencil_executor, aliased_args_keep_order) {
+            using backend_t = backend::naive;
+            auto domain = hymap::keys<int_t<0>, int_t<1>>::make_values(2_c, 3_c);
+
+            int a[2][3] = {}, b[2][3];
+            for (int i = 0; i < 2; ++i)
+                for (int j = 0; j < 3; ++j)
+                    b[i][j] = 3 * i + j;
+
+            // args 1 and 2 alias: the stages look independent by index, but must run in order
+            make_stencil_executor(backend_t(), domain, std::tuple<>(), make_iterator_mock())
+                .arg(a)
+                .arg(b)
+                .arg(b)
+                .assign(1_c, stencil(), 2_c)
+                .assign(0_c, stencil(), 2_c)
+                .execute();
+
+            for (int i = 0; i < 2; ++i)
+                for (int j = 0; j < 3; ++j) {
+                    EXPECT_EQ(b[i][j], (3 * i + j) * 2);
+                    EXPECT_EQ(a[i][j], (3 * i + j) * 4);
+                }
+        }
+
+        TEST(stencil_executor, prepared) {
+            using backend_t = backend::naive;
+            auto domain = hymap::keys<int_t<0>, int_t<1>>::make_values(2_c, 3_c);
+
+            int a[2][3] = {}, b[2][3] = {}, c[2][3] = {};
+
+            auto prepared = make_stencil_executor(backend_t(), domain, std::tuple<>(), make_iterator_mock())
+                                .arg(a)
+                                .arg(b)
+                                .arg(c)
+                                .assign(1_c, stencil(), 2_c)
+                                .assign(0_c, stencil(), 1_c)
+                                .prepare();
+
+            for (int step = 0; step < 3; ++step) {
+                for (int i = 0; i < 2; ++i)
+                    for (int j = 0; j < 3; ++j)
+                        c[i][j] = 3 * i + j + step;
+                prepared.execute();
+                for (int i = 0; i < 2; ++i)
+                    for (int j = 0; j < 3; ++j) {
+                        EXPECT_EQ(a[i][j], c[i][j] * 4);
+                        EXPECT_EQ(b[i][j], c[i][j] * 2);
+                    }
+            }
+        }
+
+        TEST(vertical_executor, prepared) {
+            using backend_t = backend::naive;
+            auto domain = hymap::keys<int_t<0>, int_t<1>>::make_values(2_c, 3_c);
+
+            int a[2][3] = {}, b[2][3];
+            for (int i = 0; i < 2; ++i)
+                for (int j = 0; j < 3; ++j)
+                    b[i][j] = 3 * i + j;
+
+            auto prepared = make_vertical_executor<int_t<1>>(backend_t(), domain, std::tuple<>(), make_iterator_mock())
+                                .arg(a)
+                                .arg(b)
+                                .assign(0_c, fwd_sum_scan(), 42, 1_c)
+                                .prepare();
+
+            for (int step = 0; step < 3; ++step) {
+                for (int i = 0; i < 2; ++i)
+                    for (int j = 0; j < 3; ++j)
+                        b[i][j] = 3 * i + j + step;
+                prepared.execute();
+                for (int i = 0; i < 2; ++i) {
+                    int res = 42;
+                    for (int j = 0; j < 3; ++j) {
+                        res += b[i][j];
+                        EXPECT_EQ(a[i][j], res);
+                    }
+                }
+            }
+        }
     } // namespace
 } // namespace gridtools::fn
@@ -34,6 +34,64 @@ namespace gridtools::fn {
             }
         };
 
+        struct other_stencil {
+            GT_FUNCTION constexpr auto operator()() const {
+                return [](auto const &iter) { return *iter + 1; };
+            }
+        };
+
+        // independent stages are fused
+        static_assert(std::is_same_v<schedule_stencil_stages<meta::list<stencil_stage<stencil, 0, 2>,
+                                         stencil_stage<other_stencil, 1, 2>>>,
+            meta::list<merged_stencil_stage<stencil_stage<stencil, 0, 2>, stencil_stage<other_stencil, 1, 2>>>>);
+
+        // read after write
+        static_assert(std::is_same_v<schedule_stencil_stages<meta::list<stencil_stage<stencil, 1, 2>,
+                                         stencil_stage<other_stencil, 0, 1>>>,
+            meta::list<stencil_stage<stencil, 1, 2>, stencil_stage<other_stencil, 0, 1>>>);
+
+        // write after read
+        static_assert(std::is_same_v<schedule_stencil_stages<meta::list<stencil_stage<stencil, 0, 1>,
+                                         stencil_stage<other_stencil, 1, 2>>>,
+            meta::list<stencil_stage<stencil, 0, 1>, stencil_stage<other_stencil, 1, 2>>>);
+
+        // write after write
+        static_assert(std::is_same_v<schedule_stencil_stages<meta::list<stencil_stage<stencil, 0, 1>,
+                                         stencil_stage<other_stencil, 0, 2>>>,
+            meta::list<stencil_stage<stencil, 0, 1>, stencil_stage<other_stencil, 0, 2>>>);
+
+        // a later independent stage is moved up to the first level
+        static_assert(std::is_same_v<schedule_stencil_stages<meta::list<stencil_stage<stencil, 1, 3>,
+                                         stencil_stage<stencil, 0, 1>,
+                                         stencil_stage<other_stencil, 2, 3>>>,
+            meta::list<merged_stencil_stage<stencil_stage<stencil, 1, 3>, stencil_stage<other_stencil, 2, 3>>,
+                stencil_stage<stencil, 0, 1>>>);
+
+        static_assert(std::is_same_v<schedule_stencil_stages<meta::list<>>, meta::list<>>);
+
+        // the producer of a transient is inlined into its consumers
+        static_assert(std::is_same_v<inline_transients<meta::list<stencil_stage<stencil, 1, 2>,
+                                                           stencil_stage<other_stencil, 0, 1, 2>>,
+                                         meta::list<int_t<1>>>,
+            meta::list<inlined_stencil_stage<other_stencil, 0, lifted_arg<stencil, int_t<2>>, int_t<2>>>>);
+
+        // transients of transients
+        static_assert(std::is_same_v<inline_transients<meta::list<stencil_stage<stencil, 1, 3>,
+                                                           stencil_stage<stencil, 2, 1>,
+                                                           stencil_stage<other_stencil, 0, 2>>,
+                                         meta::list<int_t<1>, int_t<2>>>,
+            meta::list<inlined_stencil_stage<other_stencil, 0, lifted_arg<stencil, lifted_arg<stencil, int_t<3>>>>>>);
+
+        // without transients nothing changes
+        using dependent_stages_t = meta::list<stencil_stage<stencil, 1, 2>, stencil_stage<other_stencil, 0, 1>>;
+        static_assert(std::is_same_v<inline_transients<dependent_stages_t, meta::list<>>, dependent_stages_t>);
+
+        // inlined stages are scheduled by the args they read from memory
+        using inlined_stage0_t = inlined_stencil_stage<stencil, 0, lifted_arg<stencil, int_t<2>>>;
+        using inlined_stage1_t = inlined_stencil_stage<stencil, 1, lifted_arg<stencil, int_t<2>>>;
+        static_assert(std::is_same_v<schedule_stencil_stages<meta::list<inlined_stage0_t, inlined_stage1_t>>,
+            meta::list<merged_stencil_stage<inlined_stage0_t, inlined_stage1_t>>>);
+
         TEST(stencil_stage, smoke) {
             int in[1] = {42}, out[1] = {0};
 
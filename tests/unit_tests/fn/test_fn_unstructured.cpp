@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 
 #include <gridtools/fn/backend/naive.hpp>
+#include <gridtools/fn/csr_neighbor_table.hpp>
 #include <gridtools/sid/synthetic.hpp>
 
 namespace gridtools::fn {
@@ -35,6 +36,16 @@ namespace gridtools::fn {
             }
         };
 
+        template <class C>
+        struct reduction_stencil {
+            GT_FUNCTION constexpr auto operator()() const {
+                return [](auto const &in) {
+                    return neighbor_reduction(
+                        in, C(), [](int acc, auto const &shifted, int) { return acc + deref(shifted); }, 0);
+                };
+            }
+        };
+
         struct v2v {};
         struct v2e {};
 
@@ -101,5 +112,37 @@ namespace gridtools::fn {
                 }
         }
 
+        TEST(unstructured, v2v_csr_reduction) {
+            auto apply_stencil = [](auto &&executor, auto &out, auto const &in) {
+                executor().arg(out).arg(in).assign(0_c, reduction_stencil<v2v>(), 1_c).execute();
+            };
+            auto fencil = [&](auto const &v2v_table, int nvertices, int nlevels, auto &out, auto const &in) {
+                auto v2v_conn = connectivity<v2v>(v2v_table);
+                auto domain = unstructured_domain({nvertices, nlevels}, {}, v2v_conn);
+                auto backend = make_backend(backend::naive(), domain);
+                apply_stencil(backend.stencil_executor(), out, in);
+            };
+
+            int v2v_offsets[4] = {0, 2, 3, 6};
+            int v2v_indices[6] = {1, 2, 0, 0, 1, 2};
+            auto v2v_table = csr_neighbor_table::as_neighbor_table<integral_constant<int, 0>, 3>(
+                v2v_offsets, v2v_indices);
+
+            int in[3][5], out[3][5] = {};
+            for (int v = 0; v < 3; ++v)
+                for (int k = 0; k < 5; ++k)
+                    in[v][k] = 5 * v + k;
+
+            fencil(v2v_table, 3, 5, out, in);
+
+            for (int v = 0; v < 3; ++v)
+                for (int k = 0; k < 5; ++k) {
+                    int nbsum = 0;
+                    for (int i = v2v_offsets[v]; i < v2v_offsets[v + 1]; ++i)
+                        nbsum += in[v2v_indices[i]][k];
+                    EXPECT_EQ(out[v][k], nbsum);
+                }
+        }
+
     } // namespace
 } // namespace gridtools::fn
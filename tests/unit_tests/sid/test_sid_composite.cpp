@@ -162,6 +162,73 @@ namespace gridtools {
             EXPECT_EQ(&four[1][2][3], at_key<d>(ptr));
         }
 
+        TEST(composite, indexed) {
+            double const one[5] = {0, 10, 20, 30, 40};
+            double two = -1;
+            double three[4][3][5] = {};
+            char four[4][3][5] = {};
+
+            auto my_strides = array{1, 5, 15};
+
+            auto testee = sid::composite::keys<a, b, c, d>::make_indexed_values(                 //
+                sid::synthetic()                                                                 //
+                    .set<property::origin>(sid::host_device::simple_ptr_holder(&one[0]))         //
+                    .set<property::strides>(tuple(1_c))                                          //
+                ,                                                                                //
+                sid::synthetic()                                                                 //
+                    .set<property::origin>(sid::host_device::simple_ptr_holder(&two))            //
+                ,                                                                                //
+                sid::synthetic()                                                                 //
+                    .set<property::origin>(sid::host_device::simple_ptr_holder(&three[0][0][0])) //
+                    .set<property::strides>(my_strides)                                          //
+                    .set<property::strides_kind, my_strides_kind>()                              //
+                ,                                                                                //
+                sid::synthetic()                                                                 //
+                    .set<property::origin>(sid::host_device::simple_ptr_holder(&four[0][0][0]))  //
+                    .set<property::strides>(my_strides)                                          //
+                    .set<property::strides_kind, my_strides_kind>()                              //
+            );
+            static_assert(is_sid<decltype(testee)>());
+
+            auto &&strides = sid::get_strides(testee);
+            auto ptr = sid::get_origin(testee)();
+            // `c` and `d` share the offset
+            static_assert(tu::size<decltype(ptr.m_offsets.m_vals)>::value == 3);
+
+            EXPECT_EQ(0, at_key<a>(*ptr));
+            EXPECT_EQ(-1, at_key<b>(*ptr));
+            EXPECT_EQ(&four[0][0][0], at_key<d>(ptr));
+
+            sid::shift(ptr, sid::get_stride<dim_i>(strides), 3_c);
+            EXPECT_EQ(30, at_key<a>(*ptr));
+            *at_key<b>(ptr) = *at_key<a>(ptr);
+            EXPECT_EQ(30, two);
+
+            sid::shift(ptr, sid::get_stride<dim_j>(strides), 2);
+            sid::shift(ptr, sid::get_stride<dim_k>(strides), 1);
+            EXPECT_EQ(&three[1][2][3], at_key<c>(ptr));
+            EXPECT_EQ(&four[1][2][3], at_key<d>(ptr));
+
+            sid::ptr_diff_type<decltype(testee)> ptr_diff;
+            sid::shift(ptr_diff, sid::get_stride<dim_i>(strides), -1);
+            sid::shift(ptr_diff, sid::get_stride<dim_k>(strides), 2);
+            ptr = ptr + ptr_diff;
+            EXPECT_EQ(20, at_key<a>(*ptr));
+            EXPECT_EQ(&three[3][2][2], at_key<c>(ptr));
+            EXPECT_EQ(&four[3][2][2], at_key<d>(ptr));
+
+            // the origin of `a` is the first element, so only non-negative offsets are applied to it
+            sid::ptr_diff_type<decltype(testee)> origin_diff;
+            sid::shift(origin_diff, sid::get_stride<dim_i>(strides), 1);
+            sid::shift(origin_diff, sid::get_stride<dim_k>(strides), 2);
+            ptr = (sid::get_origin(testee) + origin_diff)();
+            EXPECT_EQ(10, at_key<a>(*ptr));
+            EXPECT_EQ(&three[2][0][1], at_key<c>(ptr));
+
+            auto raw_ptrs = tu::transform([](auto ptr) { return ptr; }, ptr);
+            EXPECT_EQ(&four[2][0][1], at_key<d>(raw_ptrs));
+        }
+
         struct dim_x;
         struct dim_y;
         struct dim_z;
@@ -0,0 +1,64 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/sid/convert.hpp>
+
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/common/float16.hpp>
+#include <gridtools/sid/concept.hpp>
+
+namespace gridtools {
+    namespace {
+        TEST(convert, read_only) {
+            float const data[2][3] = {{0, 1, 2}, {10, 11, 12.5}};
+            auto testee = sid::convert<double>(data);
+            static_assert(is_sid<decltype(testee)>::value);
+            static_assert(std::is_same_v<sid::reference_type<decltype(testee)>, double>);
+
+            auto ptr = sid::get_origin(testee)();
+            auto strides = sid::get_strides(testee);
+            EXPECT_EQ(*ptr, 0.);
+            sid::shift(ptr, sid::get_stride<integral_constant<int, 0>>(strides), 1);
+            sid::shift(ptr, sid::get_stride<integral_constant<int, 1>>(strides), 2);
+            EXPECT_EQ(*ptr, 12.5);
+        }
+
+        TEST(convert, read_write) {
+            bfloat16_t data[2][3] = {};
+            auto testee = sid::convert<double>(data);
+            static_assert(is_sid<decltype(testee)>::value);
+
+            auto ptr = sid::get_origin(testee)();
+            auto strides = sid::get_strides(testee);
+            *sid::shifted(ptr, sid::get_stride<integral_constant<int, 1>>(strides), 1) = 1.5;
+            EXPECT_EQ(float(data[0][1]), 1.5f);
+
+            *ptr = 2.;
+            *ptr += 1;
+            *ptr *= 4;
+            double val = *ptr;
+            EXPECT_EQ(val, 12.);
+            EXPECT_EQ(*ptr - 2, 10.);
+        }
+
+        TEST(convert, ptr_diff) {
+            float16_t data[2][3] = {};
+            auto testee = sid::convert<float>(data);
+            auto ptr = sid::get_origin(testee)();
+            auto ptr_diff = sid::ptr_diff_type<decltype(testee)>();
+            sid::shift(ptr_diff, sid::get_stride<integral_constant<int, 0>>(sid::get_strides(testee)), 1);
+            *(ptr + ptr_diff) = 3;
+            EXPECT_EQ(float(data[1][0]), 3.f);
+        }
+    } // namespace
+} // namespace gridtools
@@ -0,0 +1,51 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil/cpu_ifirst/execinfo.hpp>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil/frontend/make_grid.hpp>
+
+using namespace gridtools;
+using namespace stencil;
+using namespace cpu_ifirst_backend;
+
+TEST(execinfo, split_along_j) {
+    execinfo testee(make_grid(100, 40, 10), 4);
+    EXPECT_EQ(testee.i_blocks(), 1);
+    EXPECT_EQ(testee.j_blocks(), 4);
+    EXPECT_EQ(testee.i_block_size(), 100);
+    EXPECT_EQ(testee.j_block_size(), 10);
+    EXPECT_EQ(testee.block(0, 3).j_block_size, 10);
+}
+
+TEST(execinfo, split_along_i_on_small_domains) {
+    execinfo testee(make_grid(100, 2, 10), 8);
+    EXPECT_EQ(testee.i_blocks(), 4);
+    EXPECT_EQ(testee.j_blocks(), 2);
+    EXPECT_EQ(testee.i_block_size(), 25);
+    EXPECT_EQ(testee.j_block_size(), 1);
+}
+
+TEST(execinfo, blocks_fit_into_cache) {
+    // a column of the fields takes 10 levels of 128 bytes, a row of a block 128000 bytes
+    execinfo testee(make_grid(100, 200, 10), 2, 1280);
+    EXPECT_EQ(testee.i_blocks(), 1);
+    EXPECT_EQ(testee.j_block_size(), 8);
+    EXPECT_EQ(testee.j_blocks(), 25);
+    EXPECT_EQ(testee.block(0, 24).j_block_size, 8);
+}
+
+TEST(execinfo, small_blocks_are_kept) {
+    execinfo testee(make_grid(100, 200, 10), 2, 8);
+    EXPECT_EQ(testee.j_block_size(), 100);
+    EXPECT_EQ(testee.j_blocks(), 2);
+}
@@ -0,0 +1,147 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil/cpu_ifirst.hpp>
+
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/common/omp.hpp>
+#include <gridtools/stencil/cartesian.hpp>
+#include <gridtools/storage/builder.hpp>
+#include <gridtools/storage/cpu_ifirst.hpp>
+#include <gridtools/storage/sid.hpp>
+
+namespace {
+    using namespace gridtools;
+    using namespace stencil;
+    using namespace cartesian;
+
+    using kfull = axis<1>::full_interval;
+
+    struct prefix_sum {
+        using in = in_accessor<0>;
+        using out = inout_accessor<1, extent<0, 0, 0, 0, -1, 0>>;
+        using param_list = make_param_list<in, out>;
+
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval, kfull::first_level) {
+            eval(out()) = eval(in());
+        }
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval, kfull::modify<1, 0>) {
+            eval(out()) = eval(in()) + eval(out(0, 0, -1));
+        }
+    };
+
+    struct upper_average {
+        using in = in_accessor<0, extent<0, 0, 0, 0, 0, 1>>;
+        using out = inout_accessor<1>;
+        using param_list = make_param_list<in, out>;
+
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval, kfull::modify<0, -1>) {
+            eval(out()) = .5 * (eval(in()) + eval(in(0, 0, 1)));
+        }
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval, kfull::last_level) {
+            eval(out()) = eval(in());
+        }
+    };
+
+    struct damped_suffix_sum {
+        using in = in_accessor<0>;
+        using out = inout_accessor<1, extent<0, 0, 0, 0, 0, 1>>;
+        using param_list = make_param_list<in, out>;
+
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval, kfull::last_level) {
+            eval(out()) = eval(in());
+        }
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval, kfull::modify<0, -1>) {
+            eval(out()) = eval(in()) - .1 * eval(out(0, 0, 1));
+        }
+    };
+
+    struct lower_sum {
+        using in = in_accessor<0, extent<0, 0, 0, 0, -1, 0>>;
+        using out = inout_accessor<1>;
+        using param_list = make_param_list<in, out>;
+
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval, kfull::first_level) {
+            eval(out()) = eval(in());
+        }
+        template <class Eval>
+        GT_FUNCTION static void apply(Eval &&eval, kfull::modify<1, 0>) {
+            eval(out()) = eval(in()) + eval(in(0, 0, -1));
+        }
+    };
+
+    const auto spec = [](auto in, auto out) {
+        GT_DECLARE_TMP(double, sum, avg, back);
+        return multi_pass(execute_forward().stage(prefix_sum(), in, sum),
+            execute_forward().stage(upper_average(), sum, avg),
+            execute_backward().stage(damped_suffix_sum(), avg, back),
+            execute_forward().stage(lower_sum(), back, out));
+    };
+
+    double in(int i, int j, int k) { return i + 10 * j + .1 * k; }
+
+    std::vector<double> expected_column(int i, int j, int k_size) {
+        std::vector<double> sum(k_size), avg(k_size), back(k_size), out(k_size);
+        for (int k = 0; k < k_size; ++k)
+            sum[k] = in(i, j, k) + (k ? sum[k - 1] : 0);
+        for (int k = 0; k < k_size; ++k)
+            avg[k] = k < k_size - 1 ? .5 * (sum[k] + sum[k + 1]) : sum[k];
+        for (int k = k_size - 1; k >= 0; --k)
+            back[k] = avg[k] - (k < k_size - 1 ? .1 * back[k + 1] : 0);
+        for (int k = 0; k < k_size; ++k)
+            out[k] = back[k] + (k ? back[k - 1] : 0);
+        return out;
+    }
+
+    struct kserial_pipeline : testing::TestWithParam<std::tuple<int, int, int>> {};
+
+    TEST_P(kserial_pipeline, multi_pass) {
+        auto [i_size, j_size, k_size] = GetParam();
+        auto builder = storage::builder<storage::cpu_ifirst>.type<double>().dimensions(i_size, j_size, k_size);
+        auto out = builder.value(-1).build();
+
+        int threads = omp_get_max_threads();
+        omp_set_num_threads(8);
+        run(spec,
+            cpu_ifirst<thread_pool::omp, std::true_type>(),
+            make_grid(i_size, j_size, k_size),
+            builder.initializer(in).build(),
+            out);
+        omp_set_num_threads(threads);
+
+        auto view = out->const_host_view();
+        for (int i = 0; i < i_size; ++i)
+            for (int j = 0; j < j_size; ++j) {
+                auto expected = expected_column(i, j, k_size);
+                for (int k = 0; k < k_size; ++k)
+                    EXPECT_DOUBLE_EQ(view(i, j, k), expected[k]) << "i " << i << " j " << j << " k " << k;
+            }
+    }
+
+    // with 8 threads, the domains with fewer than 8 j-columns and more than one chunk of levels are pipelined
+    INSTANTIATE_TEST_SUITE_P(domains,
+        kserial_pipeline,
+        testing::Values(std::make_tuple(10, 2, 45),
+            std::make_tuple(1, 1, 9),
+            std::make_tuple(33, 1, 100),
+            std::make_tuple(7, 3, 8),
+            std::make_tuple(12, 16, 20)));
+} // namespace
@@ -75,6 +75,32 @@ namespace {
 
     TEST_F(expandable_parameters_copy, copy) { run_computation<copy_functor>(); }
 
+    TEST_F(expandable_parameters_copy, auto_factor) {
+        expandable_run([](auto out, auto in) { return execute_parallel().stage(copy_functor(), out, in); },
+            naive(),
+            env_t::make_grid(),
+            out,
+            in);
+    }
+
+    TEST_F(expandable_parameters_copy, concurrent) {
+        concurrent_expandable_run<2>(
+            [](auto out, auto in) { return execute_parallel().stage(copy_functor(), out, in); },
+            naive(),
+            env_t::make_grid(),
+            out,
+            in);
+    }
+
+    TEST_F(expandable_parameters_copy, concurrent_auto_factor) {
+        concurrent_expandable_run(
+            [](auto out, auto in) { return execute_parallel().stage(copy_functor(), out, in); },
+            naive(),
+            env_t::make_grid(),
+            out,
+            in);
+    }
+
     struct copy_functor_with_expression {
         typedef inout_accessor<0> out;
         typedef in_accessor<1> in;
@@ -169,4 +195,23 @@ namespace {
             out);
         verify({in, in, in, in, in}, out);
     }
+
+    TEST_F(expandable_parameters, concurrent_caches) {
+        storages_t out = {env_t::make_storage(1.),
+            env_t::make_storage(2.),
+            env_t::make_storage(3.),
+            env_t::make_storage(4.),
+            env_t::make_storage(5.)};
+        auto in = env_t::make_storage(42.);
+        concurrent_expandable_run<2>(
+            [](auto in, auto out) {
+                GT_DECLARE_TMP(double, tmp);
+                return execute_parallel().ij_cached(tmp).stage(copy_functor(), tmp, in).stage(copy_functor(), out, tmp);
+            },
+            naive(),
+            env_t::make_grid(),
+            in,
+            out);
+        verify({in, in, in, in, in}, out);
+    }
 } // namespace
@@ -0,0 +1,170 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/storage/checkpoint.hpp>
+
+#include <array>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/storage/builder.hpp>
+#include <gridtools/storage/cpu_ifirst.hpp>
+#include <gridtools/storage/cpu_kfirst.hpp>
+
+namespace gridtools {
+    namespace storage {
+        namespace {
+            struct checkpoint_test : testing::TestWithParam<bool> {
+                std::string path = testing::TempDir() + "gt_test_checkpoint.bin";
+
+                checkpoint_test() { std::remove(path.c_str()); }
+                ~checkpoint_test() { std::remove(path.c_str()); }
+
+                checkpoint_options options() const {
+                    checkpoint_options res;
+                    res.compress = GetParam();
+                    res.chunk_bytes = 1000;
+                    res.max_pending_bytes = 5000;
+                    return res;
+                }
+            };
+
+            const auto ifirst = builder<cpu_ifirst>.dimensions(11, 7, 5).halos(2, 1, 0);
+            const auto kfirst = builder<cpu_kfirst>.dimensions(11, 7, 5);
+
+            double smooth(int i, int j, int k) { return 1.5 + i + .25 * j - k; }
+            int flag(int i, int j, int k) { return (i + j + k) % 3 == 0 ? 7 : 0; }
+
+            template <class Fun, class DataStore>
+            void verify(Fun fun, DataStore const &ds) {
+                auto view = ds->const_host_view();
+                auto &&lengths = ds->lengths();
+                for (int i = 0; i < (int)lengths[0]; ++i)
+                    for (int j = 0; j < (int)lengths[1]; ++j)
+                        for (int k = 0; k < (int)lengths[2]; ++k)
+                            EXPECT_EQ(view(i, j, k), fun(i, j, k)) << i << " " << j << " " << k;
+            }
+
+            TEST_P(checkpoint_test, restart_into_another_layout) {
+                {
+                    checkpoint_writer writer(path, options());
+                    writer.write(ifirst.type<double>().name("smooth").initializer(smooth).build());
+                    writer.write(ifirst.type<int const>().name("flag").initializer(flag).build());
+                    writer.write(builder<cpu_ifirst>.type<float>().name("empty").dimensions(0, 3).build());
+                    auto stats = writer.close();
+                    EXPECT_EQ(stats.raw_bytes, 11 * 7 * 5 * (sizeof(double) + sizeof(int)));
+                    EXPECT_GT(stats.file_bytes, 0);
+                }
+                checkpoint_reader reader(path);
+                EXPECT_EQ(reader.names(), (std::vector<std::string>{"empty", "flag", "smooth"}));
+
+                auto smooth_ds = kfirst.type<double>().name("smooth").build();
+                reader.read(smooth_ds);
+                verify(smooth, smooth_ds);
+
+                auto flag_ds = ifirst.type<int>().build();
+                reader.read("flag", flag_ds);
+                verify(flag, flag_ds);
+
+                EXPECT_EQ(reader.stats().raw_bytes, 11 * 7 * 5 * (sizeof(double) + sizeof(int)));
+                EXPECT_GT(reader.stats().gb_per_s(), 0);
+            }
+
+            TEST_P(checkpoint_test, masked_dimensions_are_broadcast) {
+                auto surface = [](int i, int j, int) { return smooth(i, j, 0); };
+                {
+                    checkpoint_writer writer(path, options());
+                    writer.write(
+                        ifirst.type<double>().name("surface").selector<1, 1, 0>().initializer(surface).build());
+                    writer.close();
+                }
+                checkpoint_reader reader(path);
+                auto ds = kfirst.type<double>().build();
+                reader.read("surface", ds);
+                verify(surface, ds);
+            }
+
+            TEST_P(checkpoint_test, snapshot) {
+                auto ds = ifirst.type<double>().name("field").initializer(smooth).build();
+                checkpoint_writer writer(path, options());
+                writer.write(ds);
+                ds->host_view()(0, 0, 0) = -1;
+                writer.close();
+
+                checkpoint_reader reader(path);
+                reader.read(ds);
+                verify(smooth, ds);
+            }
+
+            TEST_P(checkpoint_test, errors) {
+                {
+                    checkpoint_writer writer(path, options());
+                    auto ds = ifirst.type<double>().name("field").value(0).build();
+                    writer.write(ds);
+                    EXPECT_THROW(writer.write(ds), std::invalid_argument);
+                    writer.close();
+                }
+                checkpoint_reader reader(path);
+                EXPECT_THROW(reader.read("other", ifirst.type<double>().build()), std::invalid_argument);
+                EXPECT_THROW(reader.read("field", ifirst.type<float>().build()), std::invalid_argument);
+                EXPECT_THROW(reader.read("field", ifirst.type<std::int64_t>().build()), std::invalid_argument);
+                EXPECT_THROW(reader.read("field", builder<cpu_ifirst>.type<double>().dimensions(11, 7, 4).build()),
+                    std::invalid_argument);
+                EXPECT_THROW(checkpoint_reader(path + ".missing"), std::runtime_error);
+            }
+
+            // 1000 chunk bytes are not a multiple of the 16 byte elements
+            TEST_P(checkpoint_test, chunks_of_whole_elements) {
+                using pair_t = std::array<double, 2>;
+                auto pair = [](int i, int j, int k) { return pair_t{smooth(i, j, k), -smooth(i, j, k)}; };
+                {
+                    checkpoint_writer writer(path, options());
+                    writer.write(ifirst.type<pair_t>().name("pair").initializer(pair).build());
+                    writer.close();
+                }
+                checkpoint_reader reader(path);
+                auto ds = kfirst.type<pair_t>().build();
+                reader.read("pair", ds);
+                verify(pair, ds);
+            }
+
+            TEST(checkpoint, compression_keeps_trailing_bytes) {
+                char src[37];
+                for (size_t i = 0; i != sizeof(src); ++i)
+                    src[i] = char(i / 5);
+                auto compressed = checkpoint_impl_::compress(src, sizeof(src), 16);
+                char dst[sizeof(src)];
+                checkpoint_impl_::decompress(compressed.data(), compressed.size(), dst, sizeof(dst), 16);
+                EXPECT_EQ(std::string(dst, sizeof(dst)), std::string(src, sizeof(src)));
+            }
+
+            INSTANTIATE_TEST_SUITE_P(compression, checkpoint_test, testing::Bool());
+
+            TEST(checkpoint, compression_is_lossless) {
+                std::string path = testing::TempDir() + "gt_test_checkpoint_compression.bin";
+                auto ds = ifirst.type<int>().name("flag").initializer(flag).build();
+                checkpoint_options options;
+                options.compress = true;
+                checkpoint_writer writer(path, options);
+                writer.write(ds);
+                auto stats = writer.close();
+                EXPECT_LT(stats.file_bytes, stats.raw_bytes);
+
+                checkpoint_reader reader(path);
+                auto res = kfirst.type<int>().build();
+                reader.read("flag", res);
+                verify(flag, res);
+                std::remove(path.c_str());
+            }
+        } // namespace
+    }     // namespace storage
+} // namespace gridtools
@@ -0,0 +1,74 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/storage/checkpoint.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/gcl/GCL.hpp>
+#include <gridtools/storage/builder.hpp>
+#include <gridtools/storage/cpu_ifirst.hpp>
+#include <gridtools/storage/cpu_kfirst.hpp>
+
+namespace gridtools {
+    namespace storage {
+        namespace {
+            std::string file_of(int rank) {
+                return testing::TempDir() + "gt_test_checkpoint_mpi." + std::to_string(rank) + ".bin";
+            }
+
+            double value(int rank, int field, int i, int j, int k) {
+                return rank * 1000000. + field * 10000. + i * 100 + j * 10 + k;
+            }
+
+            // every rank writes its own file, the restart is done from the file of the next rank
+            TEST(checkpoint, one_file_per_rank) {
+                int rank = gcl::pid();
+                int next = (rank + 1) % gcl::procs();
+                constexpr int num_fields = 20;
+                auto const ifirst = builder<cpu_ifirst>.type<double>().dimensions(33, 17, 10).halos(3, 3, 0);
+                auto const kfirst = builder<cpu_kfirst>.type<double>().dimensions(33, 17, 10);
+
+                checkpoint_options options;
+                options.compress = rank % 2;
+                options.chunk_bytes = 4096;
+                checkpoint_writer writer(file_of(rank), options);
+                for (int f = 0; f != num_fields; ++f)
+                    writer.write(ifirst.name("field" + std::to_string(f))
+                                     .initializer([=](int i, int j, int k) { return value(rank, f, i, j, k); })
+                                     .build());
+                auto stats = writer.close();
+                EXPECT_EQ(stats.raw_bytes, num_fields * 33 * 17 * 10 * sizeof(double));
+                RecordProperty("write_gb_per_s", std::to_string(stats.gb_per_s()));
+                MPI_Barrier(gcl::world());
+
+                checkpoint_reader reader(file_of(next));
+                EXPECT_EQ(reader.names().size(), num_fields);
+                for (int f = 0; f != num_fields; ++f) {
+                    auto ds = kfirst.name("field" + std::to_string(f)).build();
+                    reader.read(ds);
+                    auto view = ds->const_host_view();
+                    for (int i = 0; i != 33; ++i)
+                        for (int j = 0; j != 17; ++j)
+                            for (int k = 0; k != 10; ++k)
+                                ASSERT_EQ(view(i, j, k), value(next, f, i, j, k));
+                }
+                RecordProperty("read_gb_per_s", std::to_string(reader.stats().gb_per_s()));
+                MPI_Barrier(gcl::world());
+                std::remove(file_of(rank).c_str());
+            }
+        } // namespace
+    }     // namespace storage
+} // namespace gridtools
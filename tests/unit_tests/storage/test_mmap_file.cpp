@@ -0,0 +1,93 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/storage/mmap_file.hpp>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/storage/builder.hpp>
+
+namespace gridtools {
+    namespace storage {
+        namespace {
+            struct mmap_file_test : testing::Test {
+                std::string path = testing::TempDir() + "gt_test_mmap_file.bin";
+
+                mmap_file_test() { std::remove(path.c_str()); }
+                ~mmap_file_test() { std::remove(path.c_str()); }
+            };
+
+            const auto builder = storage::builder<mmap_file>.dimensions(5, 7, 3).halos(1, 2, 0);
+
+            double fun(int i, int j, int k) { return i + 10 * j + 100 * k; }
+
+            template <class DataStore>
+            void verify(DataStore const &ds) {
+                auto view = ds->const_host_view();
+                for (int i = 0; i < 5; ++i)
+                    for (int j = 0; j < 7; ++j)
+                        for (int k = 0; k < 3; ++k)
+                            EXPECT_EQ(view(i, j, k), fun(i, j, k));
+            }
+
+            TEST_F(mmap_file_test, layout_and_alignment) {
+                auto ds = builder.traits({path}).type<double>().build();
+                auto reference = storage::builder<cpu_ifirst>.dimensions(5, 7, 3).halos(1, 2, 0).type<double>().build();
+                EXPECT_EQ(ds->strides(), reference->strides());
+                auto view = ds->host_view();
+                EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&view(1, 2, 0)) % 64, 0);
+            }
+
+            TEST_F(mmap_file_test, restart) {
+                verify(builder.traits({path}).type<double>().initializer(fun).build());
+                // the contents of the file are kept if there is no initializer
+                verify(builder.traits({path, mmap_mode::read_only}).type<double const>().build());
+                verify(builder.traits({path, mmap_mode::read_write, true, mmap_advice::sequential})
+                           .type<double>()
+                           .build());
+            }
+
+            TEST_F(mmap_file_test, copy_on_write) {
+                builder.traits({path}).type<double>().initializer(fun).build();
+                {
+                    auto ds = builder.traits({path, mmap_mode::copy_on_write}).type<double>().build();
+                    verify(ds);
+                    ds->host_view()(0, 0, 0) = -1;
+                    EXPECT_EQ(ds->const_host_view()(0, 0, 0), -1);
+                }
+                verify(builder.traits({path, mmap_mode::read_only}).type<double const>().build());
+            }
+
+            TEST_F(mmap_file_test, shared) {
+                auto writer = builder.traits({path}).type<double>().value(0).build();
+                auto reader = builder.traits({path, mmap_mode::read_only}).type<double const>().build();
+                writer->host_view()(4, 6, 2) = 42;
+                EXPECT_EQ(reader->const_host_view()(4, 6, 2), 42);
+            }
+
+            TEST_F(mmap_file_test, errors) {
+                EXPECT_THROW(builder.type<double>().build(), std::invalid_argument);
+                EXPECT_THROW(builder.traits({path, mmap_mode::read_only}).type<double const>().build(),
+                    std::runtime_error);
+                storage::builder<mmap_file>.traits({path}).type<double>().dimensions(2).build();
+                EXPECT_THROW(builder.traits({path, mmap_mode::copy_on_write}).type<double>().build(),
+                    std::runtime_error);
+                auto read_only = builder.traits({path, mmap_mode::read_only});
+                EXPECT_THROW(read_only.type<double>().build(), std::invalid_argument);
+                EXPECT_THROW(read_only.type<double const>().value(1).build(), std::invalid_argument);
+                EXPECT_THROW(read_only.type<double const>().initializer([](int, int, int) { return 1.; }).build(),
+                    std::invalid_argument);
+            }
+        } // namespace
+    }     // namespace storage
+} // namespace gridtools
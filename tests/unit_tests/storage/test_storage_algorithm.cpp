@@ -0,0 +1,126 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2023, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/storage/algorithm.hpp>
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/storage/builder.hpp>
+#include <gridtools/storage/cpu_ifirst.hpp>
+#include <gridtools/storage/cpu_kfirst.hpp>
+
+namespace gridtools {
+    namespace storage {
+        namespace {
+            const auto ifirst = builder<cpu_ifirst>.type<double>().dimensions(13, 9, 7).halos(2, 1, 0);
+            const auto kfirst = builder<cpu_kfirst>.type<double>().dimensions(13, 9, 7);
+
+            double fun(int i, int j, int k) { return 1 + i + .5 * j - .25 * k; }
+
+            template <class Fun, class DataStore>
+            void verify(Fun fun, DataStore const &ds) {
+                auto view = ds->const_host_view();
+                auto &&lengths = ds->lengths();
+                for (int i = 0; i < (int)lengths[0]; ++i)
+                    for (int j = 0; j < (int)lengths[1]; ++j)
+                        for (int k = 0; k < (int)lengths[2]; ++k)
+                            ASSERT_EQ(view(i, j, k), fun(i, j, k)) << i << " " << j << " " << k;
+            }
+
+            TEST(storage_initializer, layouts) {
+                verify(fun, ifirst.initializer(fun).build());
+                verify(fun, kfirst.initializer(fun).build());
+                verify(fun, ifirst.layout<1, 0, 2>().initializer(fun).build());
+            }
+
+            TEST(storage_initializer, masked_dimensions) {
+                auto surface = [](int i, int j, int) { return fun(i, j, 6); };
+                verify(surface, ifirst.selector<1, 1, 0>().initializer(fun).build());
+                auto column = [](int, int, int k) { return fun(12, 8, k); };
+                verify(column, kfirst.selector<0, 0, 1>().initializer(fun).build());
+                auto scalar = [](int, int, int) { return fun(12, 8, 6); };
+                verify(scalar, kfirst.selector<0, 0, 0>().initializer(fun).build());
+            }
+
+            TEST(storage_initializer, long_rows) {
+                auto ds = builder<cpu_ifirst>.type<int>().dimensions(10000, 3).initializer([](int i, int j) {
+                    return i * 3 + j;
+                }).build();
+                auto view = ds->const_host_view();
+                for (int i = 0; i != 10000; ++i)
+                    for (int j = 0; j != 3; ++j)
+                        ASSERT_EQ(view(i, j), i * 3 + j);
+            }
+
+            TEST(storage_initializer, empty) {
+                auto ds = builder<cpu_kfirst>.type<double>().dimensions(0, 5).value(1).build();
+                EXPECT_EQ(ds->length(), 0);
+            }
+
+            TEST(storage_algorithm, fill) {
+                auto ds = ifirst.initializer(fun).build();
+                fill(ds, 3);
+                verify([](int, int, int) { return 3; }, ds);
+            }
+
+            TEST(storage_algorithm, copy_between_layouts) {
+                auto src = builder<cpu_ifirst>.type<double const>().dimensions(13, 9, 7).initializer(fun).build();
+                auto dst = kfirst.build();
+                copy(dst, src);
+                verify(fun, dst);
+
+                auto res = builder<cpu_ifirst>.type<float>().dimensions(13, 9, 7).halos(2, 1, 0).build();
+                copy(res, dst);
+                verify([](int i, int j, int k) { return (float)fun(i, j, k); }, res);
+            }
+
+            TEST(storage_algorithm, copy_broadcasts_masked_dimensions) {
+                auto src = ifirst.selector<1, 1, 0>().initializer(fun).build();
+                auto dst = kfirst.build();
+                copy(dst, src);
+                verify([](int i, int j, int) { return fun(i, j, 6); }, dst);
+            }
+
+            TEST(storage_algorithm, axpy) {
+                auto x = kfirst.initializer(fun).build();
+                auto y = ifirst.value(1).build();
+                axpy(2, x, y);
+                verify([](int i, int j, int k) { return 2 * fun(i, j, k) + 1; }, y);
+            }
+
+            TEST(storage_algorithm, allclose) {
+                auto expected = kfirst.initializer(fun).build();
+                auto actual = ifirst.initializer([](int i, int j, int k) { return fun(i, j, k) * (1 + 1e-7); }).build();
+                EXPECT_TRUE(allclose(actual, expected));
+                EXPECT_FALSE(allclose(actual, expected, 1e-9));
+                EXPECT_TRUE(allclose(actual, expected, 0, 1e-4));
+
+                actual->host_view()(12, 0, 3) += 1;
+                EXPECT_FALSE(allclose(actual, expected));
+
+                copy(actual, expected);
+                EXPECT_TRUE(allclose(actual, expected, 0, 0));
+                actual->host_view()(0, 8, 6) = std::numeric_limits<double>::quiet_NaN();
+                EXPECT_FALSE(allclose(actual, expected));
+            }
+
+            TEST(storage_algorithm, lengths_mismatch) {
+                auto a = ifirst.build();
+                auto b = builder<cpu_ifirst>.type<double>().dimensions(13, 9, 6).build();
+                EXPECT_THROW(copy(a, b), std::invalid_argument);
+                EXPECT_THROW(axpy(1, a, b), std::invalid_argument);
+                EXPECT_THROW(allclose(a, b), std::invalid_argument);
+            }
+        } // namespace
+    }     // namespace storage
+} // namespace gridtools
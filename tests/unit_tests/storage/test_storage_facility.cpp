@@ -82,8 +82,16 @@ static_assert(expect_custom_layout<2, 1, 0>);
 static_assert(expect_custom_layout<1, 0>);
 static_assert(expect_custom_layout<2, -1, 1, 0>);
 
+template <class Layout, int Dim, int... Args>
+static constexpr bool expect_innermost_layout =
+    std::is_same_v<typename decltype(builder.innermost<Dim>().dimensions(Args...)())::element_type::layout_t, Layout>;
+
 #if defined(GT_STORAGE_CPU_KFIRST)
 
+static_assert(expect_innermost_layout<layout_map<0, 1, 2, 3>, 3, 1, 2, 3, 4>);
+static_assert(expect_innermost_layout<layout_map<0, 1, 2>, 2, 1, 2, 3>);
+static_assert(expect_innermost_layout<layout_map<2, 0, 1>, 0, 1, 2, 3>);
+
 static_assert(expect_layout<0>);
 static_assert(expect_layout<0, 1>);
 static_assert(expect_layout<0, 1, 2>);
@@ -125,6 +133,10 @@ static_assert(expect_special_layout<layout_map<-1, -1, -1, -1, 0>, 0, 0, 0, 0, 1
 
 #elif defined(GT_STORAGE_CPU_IFIRST)
 
+static_assert(expect_innermost_layout<layout_map<2, 0, 1, 3>, 3, 1, 2, 3, 4>);
+static_assert(expect_innermost_layout<layout_map<2, 0, 1>, 0, 1, 2, 3>);
+static_assert(expect_innermost_layout<layout_map<1, 0, 2>, 2, 1, 2, 3>);
+
 static_assert(expect_layout<0>);
 static_assert(expect_layout<1, 0>);
 static_assert(expect_layout<2, 0, 1>);